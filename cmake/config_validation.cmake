@@ -14,3 +14,19 @@ if(NOT (BUILD_TYPE STREQUAL "Release"        OR BUILD_TYPE STREQUAL "Debug" OR
 endif()
 set(CMAKE_BUILD_TYPE ${BUILD_TYPE})
 message(STATUS "Build type: " ${CMAKE_BUILD_TYPE})
+
+# Check if the costmap kernel is correctly configured
+if(NOT (COSTMAP_KERNEL STREQUAL "SCALAR" OR COSTMAP_KERNEL STREQUAL "WAVEFRONT"))
+    set(COSTMAP_KERNEL "SCALAR")
+endif()
+add_compile_definitions(COSTMAP_KERNEL_${COSTMAP_KERNEL})
+message(STATUS "Costmap kernel: " ${COSTMAP_KERNEL})
+
+# Check if the profiling counters are correctly configured
+if(NOT (PROFILING STREQUAL "ON" OR PROFILING STREQUAL "OFF"))
+    set(PROFILING "OFF")
+endif()
+if(PROFILING STREQUAL "ON")
+    add_compile_definitions(PROFILING_ENABLED)
+endif()
+message(STATUS "Profiling: " ${PROFILING})
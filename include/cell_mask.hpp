@@ -0,0 +1,139 @@
+#ifndef CELL_MASK_HPP
+#define CELL_MASK_HPP
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "grid_size.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Class for storing a set of cells of the maze as a bit plane, one row of 64 bit words per maze row
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class CellMask : public GridSize<width, height> {
+public:
+    /**
+     * @brief Number of 64 bit words used to store one row of cells, enough for the widest maze if it is dynamic
+     */
+    static constexpr uint8_t row_words = GridSize<width, height>::dynamic ? 4 : (width + 63) / 64;
+
+    /**
+     * @brief Type to store one row of cells, one bit per cell
+     */
+    using Row = std::array<uint64_t, row_words>;
+
+    /**
+     * @brief Construct a new empty CellMask object
+     *
+     * @param size The size of the maze
+     */
+    explicit constexpr CellMask(const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Checks whether a cell is in the set
+     *
+     * @param position The position of the cell
+     * @return True if the cell is in the set, false otherwise
+     */
+    constexpr bool contains(const GridPoint& position) const;
+
+    /**
+     * @brief Adds or removes a cell from the set
+     *
+     * @param position The position of the cell
+     * @param value Whether the cell is in the set
+     */
+    constexpr void set(const GridPoint& position, bool value = true);
+
+    /**
+     * @brief Removes every cell from the set
+     */
+    constexpr void clear();
+
+    /**
+     * @brief Returns the cells of a row
+     *
+     * @param row The row of the maze
+     * @return The cells of the row as a bit mask
+     */
+    constexpr const Row& get_row(uint8_t row) const;
+
+    /**
+     * @brief Returns the cells of a row
+     *
+     * @param row The row of the maze
+     * @return The cells of the row as a bit mask
+     */
+    constexpr Row& get_row(uint8_t row);
+
+    /**
+     * @brief Calls a function for every cell in the set, in row-major order
+     *
+     * @tparam Function Type of the function, taking a GridPoint
+     * @param function The function to be called
+     */
+    template <typename Function>
+    constexpr void for_each(Function&& function) const;
+
+    /**
+     * @brief Checks whether the set is empty
+     *
+     * @return True if no cell is in the set, false otherwise
+     */
+    constexpr bool empty() const;
+
+    /**
+     * @brief Returns the smallest rectangle holding every cell of the set
+     *
+     * @return The lower left and upper right cells of the rectangle, meaningless if the set is empty
+     */
+    constexpr std::pair<GridPoint, GridPoint> get_bounds() const;
+
+    /**
+     * @brief Adds every cell of another set to this one
+     *
+     * @param other The other set
+     * @return A reference to this set
+     */
+    constexpr CellMask& operator|=(const CellMask& other);
+
+    /**
+     * @brief Moves every cell of a row one column to the right
+     *
+     * @param row The row to be shifted
+     * @return The shifted row
+     */
+    static constexpr Row shifted_east(const Row& row);
+
+    /**
+     * @brief Moves every cell of a row one column to the left
+     *
+     * @param row The row to be shifted
+     * @return The shifted row
+     */
+    static constexpr Row shifted_west(const Row& row);
+
+    /**
+     * @brief Removes the cells of a mask from a row
+     *
+     * @param row The row to be masked
+     * @param mask The cells to be removed
+     * @return The masked row
+     */
+    static constexpr Row without(const Row& row, const Row& mask);
+
+private:
+    /**
+     * @brief Bit rows of the set
+     */
+    GridBuffer<Row, height> rows{};
+};
+
+#include "../src/cell_mask.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // CELL_MASK_HPP
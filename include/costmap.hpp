@@ -0,0 +1,176 @@
+#ifndef COSTMAP_HPP
+#define COSTMAP_HPP
+
+#include <cstdint>
+
+#include "cell_mask.hpp"
+#include "grid_size.hpp"
+#include "neighbor_table.hpp"
+#include "type.hpp"
+#include "wall_map.hpp"
+
+/**
+ * @brief Class for storing the flood fill costs of a maze as a structure of arrays
+ *
+ * @note Each cell is reached from the first of its neighbors dequeued by a breadth first search. Defining
+ *       COSTMAP_KERNEL_WAVEFRONT expands the whole frontier at once with row bit masks, keeping the rank of each cell
+ *       in the visit order to pick the same neighbors, the scalar kernel uses a queue.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class Costmap : public GridSize<width, height> {
+public:
+    /**
+     * @brief Construct a new Costmap object with every cell unreached
+     *
+     * @param size The size of the maze
+     */
+    explicit Costmap(const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Recomputes the whole costmap with a flood fill from the given seed cells
+     *
+     * @param walls The walls of the maze
+     * @param seeds The cells where the flood fill starts, with cost zero
+     */
+    void reset(const WallMap<width, height>& walls, const CellMask<width, height>& seeds);
+
+    /**
+     * @brief Notifies the costmap that the wall at the front of a pose has changed
+     *
+     * @param pose The pose facing the changed wall
+     */
+    void invalidate(const GridPose& pose);
+
+    /**
+     * @brief Repairs the costmap, expanding again only the layers affected by the invalidated walls
+     *
+     * @param walls The walls of the maze
+     */
+    void repair(const WallMap<width, height>& walls);
+
+    /**
+     * @brief Returns the cost of a cell
+     *
+     * @param position The position of the cell
+     * @return The cost of the cell, 0xFFFF if it is unreachable
+     */
+    uint16_t get_cost(const GridPoint& position) const;
+
+    /**
+     * @brief Returns the distance in cells from a cell to the nearest seed
+     *
+     * @param position The position of the cell
+     * @return The distance of the cell, 0xFFFF if it is unreachable
+     */
+    uint16_t get_distance(const GridPoint& position) const;
+
+    /**
+     * @brief Returns the side through which the flood fill reached a cell
+     *
+     * @param position The position of the cell
+     * @return The side, meaningless for the seeds and the unreachable cells
+     */
+    Side get_origin(const GridPoint& position) const;
+
+private:
+    /**
+     * @brief Rewinds the flood fill to the moment the given layer started being expanded
+     *
+     * @param walls The walls of the maze
+     * @param layer The smallest distance to the seeds whose expansion may have changed
+     */
+    void rewind(const WallMap<width, height>& walls, uint16_t layer);
+
+    /**
+     * @brief Expands the flood fill queue until every reachable cell is visited
+     *
+     * @param walls The walls of the maze
+     * @param head Index of the first cell of the queue to be expanded
+     */
+    void propagate(const WallMap<width, height>& walls, uint16_t head);
+
+    /**
+     * @brief Reaches a cell from a neighbor in the previous layer, unless an earlier neighbor already reached it
+     *
+     * @param cell_index The index of the cell
+     * @param parent_index The index of the neighbor
+     * @param side The side through which the cell is reached
+     * @return True if the cell had not been reached before, false otherwise
+     */
+    bool relax(uint16_t cell_index, uint16_t parent_index, Side side);
+
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+    /**
+     * @brief Relaxes every cell of a row reached through the given side
+     *
+     * @param candidates The cells of the row reached by the frontier, before removing visited cells
+     * @param row The row of the maze
+     * @param side The side through which the cells are reached
+     */
+    void relax_row(const CellMask<width, height>::Row& candidates, uint8_t row, Side side);
+#endif
+
+    /**
+     * @brief Index of the neighbors of each cell
+     */
+    NeighborTable<width, height> neighbors;
+
+    /**
+     * @brief Cost of each cell, taking into account the turns needed to reach the seeds
+     */
+    GridBuffer<uint16_t, width * height> costs{};
+
+    /**
+     * @brief Distance in cells from each cell to the nearest seed
+     */
+    GridBuffer<uint16_t, width * height> distances{};
+
+    /**
+     * @brief Side through which each cell was reached by the flood fill
+     */
+    GridBuffer<Side, width * height> origins{};
+
+    /**
+     * @brief Cells in the order they were visited by the last flood fill, also used as its queue
+     */
+    GridBuffer<GridPoint, width * height> visit_order{};
+
+    /**
+     * @brief Number of cells visited by the last flood fill
+     */
+    uint16_t visited_count{};
+
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+    /**
+     * @brief Cells already reached by the flood fill
+     */
+    CellMask<width, height> reached;
+
+    /**
+     * @brief Cells of the layer being expanded
+     */
+    CellMask<width, height> frontier;
+
+    /**
+     * @brief Cells of the layer being reached
+     */
+    CellMask<width, height> next;
+
+    /**
+     * @brief Index of each cell in the visit order
+     */
+    GridBuffer<uint16_t, width * height> ranks{};
+#endif
+
+    /**
+     * @brief Smallest flood fill layer affected by the walls invalidated since the last repair
+     */
+    uint16_t dirty_layer{0xFFFF};
+};
+
+#include "../src/costmap.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // COSTMAP_HPP
@@ -0,0 +1,118 @@
+#ifndef GRID_SIZE_HPP
+#define GRID_SIZE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "type.hpp"
+
+/**
+ * @brief Type of a buffer with a size fixed at compile time, or chosen at runtime when the size is zero
+ *
+ * @tparam T The type of the elements
+ * @tparam size The number of elements, zero for a runtime size
+ */
+template <typename T, uint32_t size>
+using GridBuffer = std::conditional_t<size == 0, std::vector<T>, std::array<T, size>>;
+
+/**
+ * @brief Sets every element of a buffer, sizing it first if its size is chosen at runtime
+ *
+ * @tparam Buffer The type of the buffer
+ * @tparam T The type of the value
+ * @param buffer The buffer to be filled
+ * @param count The number of elements of the buffer
+ * @param value The value of the elements
+ */
+template <typename Buffer, typename T>
+constexpr void fill_buffer(Buffer& buffer, std::size_t count, const T& value);
+
+/**
+ * @brief Class for storing the size of a maze, fixed at compile time or chosen at runtime when both are zero
+ *
+ * @details Classes templated on the maze size derive from this one and read the size through it, so the same
+ *          algorithms serve the compile-time sizes of the embedded build and the runtime sizes of the tools.
+ *
+ * @tparam width The width of the maze, zero for a runtime width
+ * @tparam height The height of the maze, zero for a runtime height
+ */
+template <uint8_t width, uint8_t height>
+class GridSize {
+public:
+    static_assert(
+        (width == 0) == (height == 0), "Either both or none of the maze dimensions must be chosen at runtime"
+    );
+
+    /**
+     * @brief Whether the size is chosen at runtime
+     */
+    static constexpr bool dynamic = width == 0;
+
+    /**
+     * @brief Construct a new GridSize object with the compile-time size, or an empty size if it is dynamic
+     */
+    constexpr GridSize() = default;
+
+    /**
+     * @brief Construct a new GridSize object
+     *
+     * @param runtime_width The width of the maze, ignored if the size is fixed at compile time
+     * @param runtime_height The height of the maze, ignored if the size is fixed at compile time
+     */
+    constexpr GridSize(uint8_t runtime_width, uint8_t runtime_height);
+
+    /**
+     * @brief Returns the width of the maze
+     *
+     * @return The width of the maze
+     */
+    constexpr uint8_t get_width() const;
+
+    /**
+     * @brief Returns the height of the maze
+     *
+     * @return The height of the maze
+     */
+    constexpr uint8_t get_height() const;
+
+    /**
+     * @brief Returns the number of cells of the maze
+     *
+     * @return The number of cells
+     */
+    constexpr uint16_t get_cell_count() const;
+
+    /**
+     * @brief Returns the index of a cell in row-major order
+     *
+     * @param position The position of the cell
+     * @return The index of the cell
+     */
+    constexpr uint16_t index(const GridPoint& position) const;
+
+    /**
+     * @brief Checks whether a cell is inside the maze
+     *
+     * @param position The position of the cell
+     * @return True if the cell is inside the maze, false otherwise
+     */
+    constexpr bool is_inside(const GridPoint& position) const;
+
+private:
+    /**
+     * @brief Type taking no space, stored instead of the dimensions fixed at compile time
+     */
+    struct Fixed { };
+
+    /**
+     * @brief Width and height of the maze chosen at runtime, taking no space when the size is fixed at compile time
+     */
+    [[no_unique_address]] std::conditional_t<dynamic, std::array<uint8_t, 2>, Fixed> dimensions{};
+};
+
+#include "../src/grid_size.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // GRID_SIZE_HPP
@@ -0,0 +1,225 @@
+#ifndef HIERARCHICAL_PLANNER_HPP
+#define HIERARCHICAL_PLANNER_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "indexed_heap.hpp"
+#include "large_maze.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Class for planning routes on large mazes over an abstract graph of the borders between square clusters
+ *
+ * @details Each run of open walls between two clusters, with its cells open to each other along the border, gets a
+ *          pair of portals in its middle cell, joined by the step across. The portals of a cluster are joined by
+ *          their distances inside it, found once when the graph is built along with the distances from a few
+ *          landmark portals on the border of the maze to every portal. A query only floods the clusters of its
+ *          ends, searches the portal graph with A* guided by the landmarks and then follows the portals through
+ *          their clusters. The routes are the shortest ones through the portals, which are at most a few cells
+ *          longer than the shortest routes of the maze.
+ */
+class HierarchicalPlanner {
+public:
+    /**
+     * @brief Cost of the routes not found
+     */
+    static constexpr uint32_t unreachable = 0xFFFFFFFF;
+
+    /**
+     * @brief Construct a new HierarchicalPlanner object without any graph
+     *
+     * @param cluster_size The width and height of the clusters in cells
+     */
+    explicit HierarchicalPlanner(uint8_t cluster_size = 16);
+
+    /**
+     * @brief Builds the portal graph of a maze, which must be rebuilt whenever its walls change
+     *
+     * @param maze The maze
+     */
+    void build(const LargeMaze& maze);
+
+    /**
+     * @brief Plans a route between two cells
+     *
+     * @param maze The maze the graph was built from
+     * @param start The cell where the route starts
+     * @param goal The cell where the route ends
+     * @return The number of steps of the route, unreachable if there is none
+     */
+    uint32_t plan(const LargeMaze& maze, const LargePoint& start, const LargePoint& goal);
+
+    /**
+     * @brief Returns the cells of the last planned route, from the start to the goal
+     *
+     * @return The cells of the route, empty if none was found
+     */
+    const std::vector<LargePoint>& get_route() const;
+
+    /**
+     * @brief Returns the number of portals of the graph
+     *
+     * @return The number of portals
+     */
+    uint32_t get_portal_count() const;
+
+private:
+    /**
+     * @brief Number of landmark portals, at the corners and at the middle of the sides of the maze
+     */
+    static constexpr uint8_t landmark_count = 8;
+
+    /**
+     * @brief Type to store a cell of a cluster on the border with another cluster
+     */
+    struct Portal {
+        LargePoint position;
+        uint32_t   cluster;
+    };
+
+    /**
+     * @brief Type to store an edge of the portal graph
+     */
+    struct Link {
+        uint32_t portal;
+        uint32_t cost;
+    };
+
+    /**
+     * @brief Returns the cluster of a cell
+     *
+     * @param position The position of the cell
+     * @return The index of the cluster
+     */
+    uint32_t get_cluster(const LargePoint& position) const;
+
+    /**
+     * @brief Adds the portals of the runs of open walls on one side of a line of cells along a cluster border
+     *
+     * @param maze The maze
+     * @param first The first cell of the line
+     * @param length The number of cells of the line
+     * @param side The side of the cells facing the other cluster
+     */
+    void add_portals(const LargeMaze& maze, const LargePoint& first, uint16_t length, Side side);
+
+    /**
+     * @brief Chooses the landmark portals and finds their distances to every portal over the portal graph
+     *
+     * @param maze The maze
+     */
+    void add_landmarks(const LargeMaze& maze);
+
+    /**
+     * @brief Returns a lower bound of the route cost from a portal to the goal of the current query
+     *
+     * @param portal The portal
+     * @param goal The goal of the query
+     * @return The lower bound, the largest of the distance in cells and the ones given by the landmarks
+     */
+    float estimate(uint32_t portal, const LargePoint& goal) const;
+
+    /**
+     * @brief Finds the distances from a cell to the other cells of its cluster, without leaving it
+     *
+     * @param maze The maze
+     * @param origin The cell where the search starts
+     */
+    void search_cluster(const LargeMaze& maze, const LargePoint& origin);
+
+    /**
+     * @brief Returns the distance found by the last cluster search
+     *
+     * @param position The position of a cell of the searched cluster
+     * @return The distance of the cell, unreachable if it is not reachable inside the cluster
+     */
+    uint32_t get_cluster_distance(const LargePoint& position) const;
+
+    /**
+     * @brief Appends to the route the cells from one of its cells to another one of the same cluster
+     *
+     * @param maze The maze
+     * @param from The last cell of the route
+     * @param to The cell to be reached
+     */
+    void append_path(const LargeMaze& maze, const LargePoint& from, const LargePoint& to);
+
+    /**
+     * @brief Width and height of the clusters in cells
+     */
+    uint8_t cluster_size;
+
+    /**
+     * @brief Number of clusters in each row
+     */
+    uint32_t cluster_columns{};
+
+    /**
+     * @brief Portals of the graph
+     */
+    std::vector<Portal> portals;
+
+    /**
+     * @brief Edges leaving each portal
+     */
+    std::vector<std::vector<Link>> links;
+
+    /**
+     * @brief Portals of each cluster
+     */
+    std::vector<std::vector<uint32_t>> cluster_portals;
+
+    /**
+     * @brief Distance over the portal graph from each landmark to each portal, indexed by portal and then by landmark
+     */
+    std::vector<uint32_t> landmark_distances;
+
+    /**
+     * @brief Distance over the portal graph from each landmark to the goal of the current query
+     */
+    std::array<uint32_t, landmark_count> goal_landmark_distances{};
+
+    /**
+     * @brief First cell of the cluster searched last
+     */
+    LargePoint cluster_origin{};
+
+    /**
+     * @brief Distances found by the last cluster search, in row-major order inside the cluster
+     */
+    std::vector<uint32_t> cluster_distances;
+
+    /**
+     * @brief Queue of the cluster search, as cell indices inside the cluster
+     */
+    std::vector<uint16_t> cluster_queue;
+
+    /**
+     * @brief Cost of reaching each portal in the current query, followed by the cost of reaching the goal
+     */
+    std::vector<uint32_t> costs;
+
+    /**
+     * @brief Portal each portal was reached from in the current query, followed by the one the goal was reached from
+     */
+    std::vector<uint32_t> parents;
+
+    /**
+     * @brief Distance from each portal of the goal cluster to the goal, unreachable for the other portals
+     */
+    std::vector<uint32_t> goal_distances;
+
+    /**
+     * @brief Open portals of the query, ordered by their estimated route cost
+     */
+    IndexedHeap<0> heap;
+
+    /**
+     * @brief Cells of the last planned route
+     */
+    std::vector<LargePoint> route;
+};
+
+#endif  // HIERARCHICAL_PLANNER_HPP
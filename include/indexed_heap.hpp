@@ -0,0 +1,109 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "grid_size.hpp"
+
+/**
+ * @brief Binary min heap over a fixed set of items with decrease key, using no dynamic memory unless the
+ *        capacity is chosen at runtime
+ *
+ * @tparam capacity The number of distinct items, identified by 0 to capacity - 1, zero for a runtime capacity
+ */
+template <uint32_t capacity>
+class IndexedHeap {
+public:
+    /**
+     * @brief Type used to identify an item
+     */
+    using Index = std::conditional_t<(capacity != 0 and capacity < 0xFFFF), uint16_t, uint32_t>;
+
+    /**
+     * @brief Value representing no item
+     */
+    static constexpr Index none = std::numeric_limits<Index>::max();
+
+    /**
+     * @brief Construct a new empty IndexedHeap object
+     *
+     * @param item_count The number of distinct items, ignored if the capacity is fixed at compile time
+     */
+    explicit IndexedHeap(uint32_t item_count = capacity);
+
+    /**
+     * @brief Removes every item from the heap
+     */
+    void clear();
+
+    /**
+     * @brief Checks whether the heap is empty
+     *
+     * @return True if there are no items in the heap, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Inserts an item or lowers its key if it is already in the heap
+     *
+     * @param item The item to be inserted
+     * @param key The key of the item, ignored if higher than the current one
+     */
+    void push(Index item, float key);
+
+    /**
+     * @brief Removes the item with the lowest key
+     *
+     * @return The removed item
+     */
+    Index pop();
+
+private:
+    /**
+     * @brief Moves an item up until its parent has a lower key
+     *
+     * @param position The position of the item in the heap
+     */
+    void sift_up(Index position);
+
+    /**
+     * @brief Moves an item down until its children have higher keys
+     *
+     * @param position The position of the item in the heap
+     */
+    void sift_down(Index position);
+
+    /**
+     * @brief Swaps two items of the heap, keeping their positions updated
+     *
+     * @param first The position of the first item
+     * @param second The position of the second item
+     */
+    void swap(Index first, Index second);
+
+    /**
+     * @brief Items in heap order
+     */
+    GridBuffer<Index, capacity> heap{};
+
+    /**
+     * @brief Position of each item in the heap, none if it is not in the heap
+     */
+    GridBuffer<Index, capacity> positions{};
+
+    /**
+     * @brief Key of each item
+     */
+    GridBuffer<float, capacity> keys{};
+
+    /**
+     * @brief Number of items in the heap
+     */
+    Index size{};
+};
+
+#include "../src/indexed_heap.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // INDEXED_HEAP_HPP
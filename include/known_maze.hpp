@@ -3,27 +3,81 @@
 
 #include <array>
 #include <cstdint>
-#include <map>
 #include <ostream>
-#include <unordered_set>
 
+#include "cell_mask.hpp"
+#include "costmap.hpp"
+#include "grid_size.hpp"
+#include "maze_record.hpp"
+#include "sensor_model.hpp"
 #include "type.hpp"
+#include "wall_map.hpp"
+
+/**
+ * @brief Possible ways of exploring the maze before the fast runs
+ */
+enum ExplorationStrategy : uint8_t {
+    /**
+     * @brief Goes to the goal with the flood fill and comes back, without proving that the route is the shortest
+     */
+    GOAL = 0,
+
+    /**
+     * @brief Goes to the goal with the flood fill, then visits the cells that may be on a shorter route until the
+     *        shortest one is proven
+     */
+    PROVE_OPTIMAL = 1,
+
+    /**
+     * @brief Goes from the start to the nearest unvisited cell that may be on a shorter route until the shortest one
+     *        is proven
+     */
+    FRONTIER = 2
+};
+
+template <uint8_t width, uint8_t height>
+class MazeSnapshot;
 
 /**
  * @brief Class for storing the robot information about the maze
  *
- * @tparam width The width of the maze
- * @tparam height The height of the maze
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
  */
 template <uint8_t width, uint8_t height>
-class KnownMaze {
+class KnownMaze : public GridSize<width, height> {
 public:
     /**
      * @brief Construct a new KnownMaze object
      *
      * @param start The start pose of the robot
+     * @param size The size of the maze
      */
-    explicit KnownMaze(const GridPose& start);
+    explicit KnownMaze(const GridPose& start, const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Forgets everything about the maze, keeping its size, its goal and its memory
+     *
+     * @param start The start pose of the robot
+     */
+    void reset(const GridPose& start);
+
+    /**
+     * @brief Restores the maze from a binary record, which must have the same size as the maze
+     *
+     * @details Records without evidence count each of their walls as seen once by the front sensor, so a plain maze can
+     *          be given as a prior map.
+     *
+     * @param record The record to be loaded
+     */
+    void load(const MazeRecord& record);
+
+    /**
+     * @brief Writes a snapshot of the walls, the sensor readings, the start and the goal as a binary record
+     *
+     * @param os The output stream
+     */
+    void save(std::ostream& os) const;
 
     /**
      * @brief Updates the maze walls with the current pose and new information
@@ -33,6 +87,27 @@ public:
      */
     void update(const GridPose& pose, Information information);
 
+    /**
+     * @brief Records the readings of the sensors without updating the costmaps, for the cells the robot drives through
+     *        without stopping, the next update taking them into account
+     *
+     * @param pose The pose of the robot
+     * @param information The information from the distance sensors
+     */
+    void read(const GridPose& pose, const Information& information);
+
+    /**
+     * @brief Checks whether readings would change the decision about a wall or whether it was seen free
+     *
+     * @details Readings that change neither leave the costmaps and the exploration as they are, so an update with them
+     *          would not change the next cell either.
+     *
+     * @param pose The pose of the robot
+     * @param information The information from the distance sensors
+     * @return True if the readings bring news about the walls, false otherwise
+     */
+    bool changes_map(const GridPose& pose, const Information& information) const;
+
     /**
      * @brief Returns the next point the robot should go to
      *
@@ -42,47 +117,255 @@ public:
      */
     GridPoint get_current_goal(const GridPoint& position, bool force_costmap = false) const;
 
+    /**
+     * @brief Sets the cells the robot must reach, kept across resets, the central cells by default
+     *
+     * @details The goal may have any shape and be split in several regions, the flood fill going to the nearest one.
+     *          The costmaps flooded from the goal are recomputed right away, so it may also be changed between updates.
+     *
+     * @param goal The goal cells, at least one
+     */
+    void set_goal(const CellMask<width, height>& goal);
+
+    /**
+     * @brief Sets a rectangle of cells as the goal, kept across resets
+     *
+     * @param position The lower left cell of the rectangle
+     * @param goal_width The width of the rectangle in cells
+     * @param goal_height The height of the rectangle in cells
+     */
+    void set_goal(const GridPoint& position, uint8_t goal_width, uint8_t goal_height);
+
+    /**
+     * @brief Sets how the costmap is updated after new walls are found
+     *
+     * @param incremental True to repair only the cells affected by the changed walls, false to recompute everything
+     */
+    void set_incremental_costmap(bool incremental);
+
+    /**
+     * @brief Sets how much the readings of each sensor are trusted, taking effect from the next update
+     *
+     * @param model The model of the sensors of the robot
+     */
+    void set_sensor_model(const SensorModel& model);
+
+    /**
+     * @brief Sets how the maze is explored, taking effect from the next update
+     *
+     * @param strategy The exploration strategy
+     */
+    void set_exploration_strategy(ExplorationStrategy strategy);
+
+    /**
+     * @brief Returns how the maze is explored
+     *
+     * @return The exploration strategy
+     */
+    ExplorationStrategy get_exploration_strategy() const;
+
+    /**
+     * @brief Checks whether the shortest route to the goal only goes through walls seen free
+     *
+     * @details The distance to the goal with the unseen walls open is a lower bound of the length of the route, and the
+     *          distance with them closed is an upper bound, both kept up to date after every update. The route is
+     *          proven when they meet, and the robot then stops exploring and heads back to the start.
+     *
+     * @return True if no unseen wall can make the route shorter, false otherwise
+     */
+    bool is_route_proven() const;
+
+    /**
+     * @brief Returns by how many cells the shortest route through walls seen free may still be longer than the
+     *        shortest route
+     *
+     * @return The difference between the upper and lower bounds of the distance to the goal, zero once the route is
+     *         proven and 0xFFFF if no route goes only through walls seen free
+     */
+    uint16_t get_route_gap() const;
+
+    /**
+     * @brief Checks whether the robot is still exploring the maze
+     *
+     * @return True if the robot is exploring, false otherwise
+     */
+    bool is_exploring() const;
+
+    /**
+     * @brief Checks whether the robot is returning to the start
+     *
+     * @return True if the robot is returning, false otherwise
+     */
+    bool is_returning() const;
+
+    /**
+     * @brief Checks whether the robot has been in a cell
+     *
+     * @param position The position of the cell
+     * @return True if the cell was visited, false otherwise
+     */
+    bool is_visited(const GridPoint& position) const;
+
+    /**
+     * @brief Returns the goal cells of the maze
+     *
+     * @return The goal cells
+     */
+    const CellMask<width, height>& get_goal() const;
+
+    /**
+     * @brief Returns the start pose of the robot
+     *
+     * @return The start pose
+     */
+    const GridPose& get_start() const;
+
+    /**
+     * @brief Returns the current decision about the existence of each wall
+     *
+     * @return The walls of the maze
+     */
+    const WallMap<width, height>& get_walls() const;
+
+    /**
+     * @brief Returns the walls confirmed by the sensors, treating the ones never seen free as walls
+     *
+     * @return The explored walls
+     */
+    const WallMap<width, height>& get_explored_walls() const;
+
+    /**
+     * @brief Returns the flood fill cost from a cell to the goal
+     *
+     * @param position The position of the cell
+     * @return The cost of the cell
+     */
+    uint16_t get_cost(const GridPoint& position) const;
+
+    /**
+     * @brief Returns the costmap flooded from the goal through the walls
+     *
+     * @return The costmap to the goal
+     */
+    const Costmap<width, height>& get_costmap() const;
+
+    /**
+     * @brief Returns the costmap flooded from the start through the walls, which the goal strategy only keeps up to
+     *        date on the way back
+     *
+     * @return The costmap to the start
+     */
+    const Costmap<width, height>& get_start_costmap() const;
+
+    /**
+     * @brief Returns the costmap flooded from the goal through the explored walls
+     *
+     * @return The costmap to the goal through the explored walls
+     */
+    const Costmap<width, height>& get_explored_costmap() const;
+
     template <std::uint8_t w, std::uint8_t h>
     friend std::ostream& operator<<(std::ostream& os, const KnownMaze<w, h>& maze);
 
+    friend class MazeSnapshot<width, height>;
+
 private:
     /**
-     * @brief Type to store the information of a cell in the maze
+     * @brief Type to store the sensor readings about a wall
      */
-    struct Cell {
-        std::array<uint32_t, 4> wall_count{};
-        std::array<uint32_t, 4> free_count{};
-        uint16_t                cost{0xFFFF};
+    struct Evidence {
+        /**
+         * @brief Log-odds of the wall existing, in units of 1 / belief_scale, positive for a wall
+         */
+        int8_t belief{};
+
+        /**
+         * @brief Number of readings about the wall, saturating at 255
+         */
+        uint8_t reading_count{};
     };
 
+    /**
+     * @brief Number of belief units in one unit of log-odds
+     */
+    static constexpr int belief_scale = 8;
+
+    /**
+     * @brief Largest magnitude of a belief, so a wall read wrong for long can still be corrected by a few readings
+     */
+    static constexpr int belief_cap = 64;
+
+    /**
+     * @brief Returns the change of the belief of a wall after a reading
+     *
+     * @param likelihood The probability of the reading if it is right
+     * @param false_likelihood The probability of the reading if it is wrong
+     * @return The magnitude of the change, up to the belief cap
+     */
+    static int8_t get_reading_weight(float likelihood, float false_likelihood);
+
+    /**
+     * @brief Adds a reading to the evidence about a wall
+     *
+     * @param evidence The evidence about the wall
+     * @param weight The change of the log-odds of the wall, positive for a wall
+     */
+    static void add_reading(Evidence& evidence, int8_t weight);
+
+    /**
+     * @brief Returns the walls seen by the sensors from a pose
+     *
+     * @param pose The pose of the robot
+     * @return The poses facing the walls, in the order of the sensors
+     */
+    static std::array<GridPose, SensorModel::sensor_count> get_sensor_walls(const GridPose& pose);
+
+    /**
+     * @brief Returns the readings of the sensors in their order
+     *
+     * @param information The information from the distance sensors
+     * @return The readings of the sensors
+     */
+    static std::array<Information::Existence, SensorModel::sensor_count> get_readings(const Information& information);
+
     /**
      * @brief Calculates the costmap for the flood fill algorithm
      */
     void calculate_costmap();
 
     /**
-     * @brief Returns the cell at the given position
-     *
-     * @param position The position of the cell
-     * @return The cell at the given position
+     * @brief Removes every cell from the best route
+     */
+    void clear_best_route();
+
+    /**
+     * @brief Recomputes the explored walls from the readings and the explored costmap from scratch
      */
-    const Cell& get_cell(const GridPoint& position) const;
+    void reset_explored_costmap();
 
     /**
-     * @brief Returns the cell at the given position
+     * @brief Updates the belief of a wall with the reading of a sensor
      *
-     * @param position The position of the cell
-     * @return The cell at the given position
+     * @param pose The pose facing the wall
+     * @param sensor The sensor that read the wall
+     * @param reading The reading of the sensor, ignored if unknown
      */
-    Cell& get_cell(const GridPoint& position);
+    void read_wall(const GridPose& pose, Sensor sensor, Information::Existence reading);
 
     /**
      * @brief Update the probability of a wall in the maze
      *
      * @param pose The pose of the robot
-     * @param wall Whether there is a wall in front of the robot
+     * @param weight The change of the log-odds of the wall in front of the robot, positive for a wall
+     */
+    void update_wall(const GridPose& pose, int8_t weight);
+
+    /**
+     * @brief Forgets the walls between the cells reached by a costmap and the ones it cannot reach
+     *
+     * @param costmap The costmap whose seeds the robot cannot reach
      */
-    void update_wall(const GridPose& pose, bool wall);
+    void forget_enclosing_walls(const Costmap<width, height>& costmap);
 
     /**
      * @brief Checks whether there is a wall at the front of a given pose
@@ -93,19 +376,157 @@ private:
     bool has_wall(const GridPose& pose) const;
 
     /**
-     * @brief Cells matrix representing the maze
+     * @brief Returns the open neighbor with the lowest cost in a costmap
+     *
+     * @param costmap The costmap to descend
+     * @param walls The walls that cannot be crossed
+     * @param position The current position of the robot
+     * @return The neighbor with the lowest cost, or the same position if none is lower
+     */
+    GridPoint descend(
+        const Costmap<width, height>& costmap, const WallMap<width, height>& walls, const GridPoint& position
+    ) const;
+
+    /**
+     * @brief Rebuilds the best route from the start to the goal following a costmap
+     *
+     * @param costmap The costmap flooded from the goal
+     * @param walls The walls the costmap was flooded with
+     */
+    void calculate_best_route(const Costmap<width, height>& costmap, const WallMap<width, height>& walls);
+
+    /**
+     * @brief Checks whether the route is proven and updates the cells left to be explored
+     */
+    void update_exploration();
+
+    /**
+     * @brief Fills a wall map with the walls confirmed by the sensors, treating the ones never seen free as walls
+     *
+     * @param explored_walls The wall map to be filled
+     */
+    void fill_explored_walls(WallMap<width, height>& explored_walls) const;
+
+    /**
+     * @brief Current decision about the existence of each wall
+     */
+    WallMap<width, height> walls;
+
+    /**
+     * @brief Readings about the walls on the right side of each cell
+     */
+    GridBuffer<Evidence, width * height> east_evidence{};
+
+    /**
+     * @brief Readings about the walls on the upper side of each cell
+     */
+    GridBuffer<Evidence, width * height> north_evidence{};
+
+    /**
+     * @brief Change of the belief of a wall read as a wall by each sensor
      */
-    std::array<std::array<Cell, width>, height> cells{};
+    std::array<int8_t, SensorModel::sensor_count> wall_weights{};
+
+    /**
+     * @brief Change of the belief of a wall read as free by each sensor
+     */
+    std::array<int8_t, SensorModel::sensor_count> free_weights{};
+
+    /**
+     * @brief Number of changes of the current decision about the walls, so the caches built from them can tell
+     *        whether they are still valid
+     */
+    uint32_t map_version{};
+
+    /**
+     * @brief Number of changes of the walls seen free by the sensors
+     */
+    uint32_t explored_version{};
+
+    /**
+     * @brief Map version the costmap was last computed for
+     */
+    uint32_t costmap_version{};
+
+    /**
+     * @brief Map version the start costmap was last computed for
+     */
+    uint32_t start_costmap_version{};
+
+    /**
+     * @brief Explored version the explored costmap was last computed for
+     */
+    uint32_t explored_costmap_version{};
+
+    /**
+     * @brief Map version the best route was last built for
+     */
+    uint32_t best_route_version{};
+
+    /**
+     * @brief Flood fill costs to the goal
+     */
+    Costmap<width, height> costmap;
+
+    /**
+     * @brief Flood fill costs to the start, used to return when off the best route
+     */
+    Costmap<width, height> start_costmap;
+
+    /**
+     * @brief Flood fill costs over the explored walls only, used to prove the route
+     */
+    Costmap<width, height> explored_costmap;
+
+    /**
+     * @brief Flood fill costs to the cells left to be explored
+     */
+    Costmap<width, height> frontier_costmap;
+
+    /**
+     * @brief Walls seen free by the sensors, all the others taken as walls
+     */
+    WallMap<width, height> explored_walls;
+
+    /**
+     * @brief Unvisited cells on any of the shortest possible routes, empty while the strategy does not visit them
+     */
+    CellMask<width, height> frontier;
+
+    /**
+     * @brief Cells the robot has been in
+     */
+    CellMask<width, height> visited;
+
+    /**
+     * @brief Whether the costmap is repaired incrementally instead of recomputed
+     */
+    bool incremental_costmap{true};
+
+    /**
+     * @brief How the maze is explored
+     */
+    ExplorationStrategy strategy{ExplorationStrategy::GOAL};
+
+    /**
+     * @brief Whether the shortest route only goes through walls seen free
+     */
+    bool route_proven{};
 
     /**
      * @brief Start pose of the robot in the maze
      */
     GridPose start;
 
+    /**
+     * @brief Start cell, used as the seed of the start costmap
+     */
+    CellMask<width, height> start_cell;
+
     /**
      * @brief Goal points in the maze
      */
-    std::unordered_set<GridPoint> goal;
+    CellMask<width, height> goal;
 
     /**
      * @brief Whether the robot is returning to the start
@@ -118,9 +539,19 @@ private:
     bool exploring{true};
 
     /**
-     * @brief Current best found route to the goal
+     * @brief Current best found route to the goal, indexed by step from the start
+     */
+    GridBuffer<GridPoint, width * height> best_route{};
+
+    /**
+     * @brief Number of cells in the best route
+     */
+    uint16_t best_route_length{};
+
+    /**
+     * @brief Step of each cell in the best route, 0xFFFF if the cell is not on it
      */
-    std::map<uint16_t, GridPoint, std::greater<>> best_route;
+    GridBuffer<uint16_t, width * height> best_route_step{};
 };
 
 #include "../src/known_maze.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
@@ -0,0 +1,160 @@
+#ifndef LARGE_MAZE_HPP
+#define LARGE_MAZE_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "type.hpp"
+
+/**
+ * @brief Type to store a point in a grid with up to 65535 cells per side
+ */
+struct LargePoint {
+    /**
+     * @brief Moves in the grid in the direction of the side
+     *
+     * @param side The side to move to
+     * @return The new point after moving, wrapped around to 65535 past the bottom and left borders
+     */
+    constexpr LargePoint operator+(const Side& side) const;
+
+    /**
+     * @brief Compares two points for equality
+     *
+     * @param other The other point to compare
+     * @return True if the points are equal, false otherwise
+     */
+    constexpr bool operator==(const LargePoint& other) const;
+
+    /**
+     * @brief The x coordinate of the point on the grid
+     */
+    uint16_t x;
+
+    /**
+     * @brief The y coordinate of the point on the grid
+     */
+    uint16_t y;
+};
+
+/**
+ * @brief Class for storing the walls of mazes too large for the grid classes, used to stress the planners
+ *
+ * @details The walls are kept as bit planes with one row of 64 bit words per maze row, like the wall map, but the
+ *          size is only chosen at runtime.
+ */
+class LargeMaze {
+public:
+    /**
+     * @brief Construct a new LargeMaze object
+     *
+     * @param width The width of the maze
+     * @param height The height of the maze
+     * @param walls Whether the inner walls start set
+     */
+    LargeMaze(uint16_t width, uint16_t height, bool walls = true);
+
+    /**
+     * @brief Returns the width of the maze
+     *
+     * @return The width of the maze
+     */
+    uint16_t get_width() const;
+
+    /**
+     * @brief Returns the height of the maze
+     *
+     * @return The height of the maze
+     */
+    uint16_t get_height() const;
+
+    /**
+     * @brief Returns the number of cells of the maze
+     *
+     * @return The number of cells
+     */
+    uint32_t get_cell_count() const;
+
+    /**
+     * @brief Returns the index of a cell in row-major order
+     *
+     * @param position The position of the cell
+     * @return The index of the cell
+     */
+    uint32_t index(const LargePoint& position) const;
+
+    /**
+     * @brief Checks whether a cell is inside the maze
+     *
+     * @param position The position of the cell
+     * @return True if the cell is inside the maze, false otherwise
+     */
+    bool is_inside(const LargePoint& position) const;
+
+    /**
+     * @brief Checks whether there is a wall on a side of a cell
+     *
+     * @param position The position of the cell
+     * @param side The side of the wall
+     * @return True if there is a wall or the side faces outside the maze, false otherwise
+     */
+    bool has_wall(const LargePoint& position, Side side) const;
+
+    /**
+     * @brief Sets the wall on a side of a cell, ignoring the borders
+     *
+     * @param position The position of the cell
+     * @param side The side of the wall
+     * @param wall Whether there is a wall
+     */
+    void set_wall(const LargePoint& position, Side side, bool wall);
+
+private:
+    /**
+     * @brief Returns the index of the bit storing the wall on a side of a cell, in the east or north plane
+     *
+     * @param position The position of the cell, which must be inside the maze
+     * @param side The side of the wall, which must not face outside the maze
+     * @return The index of the bit
+     */
+    uint32_t get_bit(const LargePoint& position, Side side) const;
+
+    /**
+     * @brief Width of the maze in cells
+     */
+    uint16_t width;
+
+    /**
+     * @brief Height of the maze in cells
+     */
+    uint16_t height;
+
+    /**
+     * @brief Number of 64 bit words used to store one row of cells
+     */
+    uint16_t row_words;
+
+    /**
+     * @brief Whether each cell has a wall on its right side
+     */
+    std::vector<uint64_t> east_walls;
+
+    /**
+     * @brief Whether each cell has a wall on its upper side
+     */
+    std::vector<uint64_t> north_walls;
+};
+
+constexpr LargePoint LargePoint::operator+(const Side& side) const {
+    constexpr std::array<int8_t, 4> x_steps = {1, 0, -1, 0};
+    constexpr std::array<int8_t, 4> y_steps = {0, 1, 0, -1};
+
+    return {static_cast<uint16_t>(this->x + x_steps[side]), static_cast<uint16_t>(this->y + y_steps[side])};
+}
+
+constexpr bool LargePoint::operator==(const LargePoint& other) const {
+    return this->x == other.x and this->y == other.y;
+}
+
+#endif  // LARGE_MAZE_HPP
@@ -0,0 +1,65 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Read only memory mapping of a whole file
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Construct a new MappedFile object, mapping the file into memory
+     *
+     * @param filename The name of the file to be mapped
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     * @brief Destroy the MappedFile object, unmapping the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Construct a new MappedFile object taking over the mapping of another one
+     *
+     * @param other The mapping to be taken over
+     */
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /**
+     * @brief Returns the contents of the file
+     *
+     * @return The contents of the file, valid while the mapping exists
+     */
+    std::string_view get_data() const;
+
+    /**
+     * @brief Lists the files to be read for a path
+     *
+     * @param path A file or a directory
+     * @return The file itself, or the regular files of the directory in name order
+     */
+    static std::vector<std::string> list_files(const std::string& path);
+
+private:
+    /**
+     * @brief Start of the mapping, null if the file is empty
+     */
+    void* address{};
+
+    /**
+     * @brief Size of the file in bytes
+     */
+    std::size_t size{};
+};
+
+#endif  // MAPPED_FILE_HPP
@@ -1,25 +1,97 @@
 #ifndef MAZE_HPP
 #define MAZE_HPP
 
-#include <array>
 #include <cstdint>
 #include <ostream>
 #include <string>
 
+#include "grid_size.hpp"
+#include "maze_reader.hpp"
+#include "maze_record.hpp"
 #include "type.hpp"
+#include "wall_map.hpp"
 
+/**
+ * @brief Class for storing the real walls of a maze and answering the readings of the sensors of a simulated robot
+ *
+ * @details The readings of every pose are computed when the maze is loaded and never written afterwards, so a maze
+ *          can be shared by threads querying it concurrently.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
 template <std::uint8_t width, std::uint8_t height>
-class Maze {
+class Maze : public GridSize<width, height> {
 public:
     Maze(const std::string& filename);
 
+    /**
+     * @brief Construct a new Maze object from a drawing read by a MazeReader
+     *
+     * @param text The drawing of the maze, which must have the same size as the maze unless its size is dynamic
+     */
+    explicit Maze(const MazeText& text);
+
+    /**
+     * @brief Construct a new Maze object from a binary record, copying its wall planes without any parsing
+     *
+     * @param record The record of the maze, which must have the same size as the maze unless its size is dynamic
+     */
+    explicit Maze(const MazeRecord& record);
+
+    /**
+     * @brief Returns the readings of the sensors of a robot, the diagonal ones being unknown behind a front wall
+     *
+     * @param pose The pose of the robot, which must be inside the maze
+     * @return The readings of the sensors
+     */
     Information get_information(const GridPose& pose) const;
 
+    /**
+     * @brief Writes the maze as a binary record, with the start at the lower left cell and the central goal region
+     *
+     * @param os The output stream
+     */
+    void save(std::ostream& os) const;
+
+    /**
+     * @brief Writes the maze as a drawing that can be read back by a MazeReader
+     *
+     * @param os The output stream
+     */
+    void save_text(std::ostream& os) const;
+
     template <std::uint8_t w, std::uint8_t h>
     friend std::ostream& operator<<(std::ostream& os, const Maze<w, h>& maze);
 
 private:
-    std::array<std::array<std::array<bool, 4>, width>, height> walls{};
+    /**
+     * @brief Loads the walls from a drawing of the maze
+     *
+     * @param text The drawing of the maze
+     */
+    void load(const MazeText& text);
+
+    /**
+     * @brief Takes the size of a maze being loaded, which must match the compile-time size unless it is dynamic
+     *
+     * @param maze_width The width of the loaded maze
+     * @param maze_height The height of the loaded maze
+     * @param location The file and position of the loaded maze, for the error message
+     */
+    void resize(std::uint8_t maze_width, std::uint8_t maze_height, const std::string& location);
+
+    /**
+     * @brief Computes the readings of the sensors in every pose from the walls
+     */
+    void build_sensor_table();
+
+    WallMap<width, height> walls;
+
+    /**
+     * @brief Readings of the sensors in every pose, indexed by cell and then by orientation
+     */
+    GridBuffer<Information, 4 * width * height> sensor_table{};
 };
 
 #include "../src/maze.cpp"
@@ -0,0 +1,212 @@
+#ifndef MAZE_GENERATOR_HPP
+#define MAZE_GENERATOR_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "large_maze.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Possible algorithms used to generate a maze
+ */
+enum MazeAlgorithm : uint8_t {
+    /**
+     * @brief Depth first search, giving long corridors with few branches
+     */
+    BACKTRACKER = 0,
+
+    /**
+     * @brief Random spanning tree joining the cells in a random wall order, giving many short dead ends
+     */
+    KRUSKAL,
+
+    /**
+     * @brief Random spanning tree grown from a single cell, giving branches radiating from it
+     */
+    PRIM,
+
+    /**
+     * @brief Depth first search with the dead ends opened into loops
+     */
+    BRAIDED,
+
+    /**
+     * @brief Contest maze, with a start cell open only to the front, a central goal with a single entry and a few
+     *        loops elsewhere
+     */
+    COMPETITION
+};
+
+/**
+ * @brief Type to store the walls of a maze before it is written
+ */
+struct MazeLayout {
+    /**
+     * @brief Construct a new MazeLayout object
+     *
+     * @param width The width of the maze
+     * @param height The height of the maze
+     * @param walls Whether the inner walls start set
+     */
+    MazeLayout(uint8_t width, uint8_t height, bool walls = true);
+
+    /**
+     * @brief Checks whether there is a wall at the front of a given pose
+     *
+     * @param pose The pose to check
+     * @return True if there is a wall or the pose faces outside the maze, false otherwise
+     */
+    bool has_wall(const GridPose& pose) const;
+
+    /**
+     * @brief Sets the wall at the front of a given pose, ignoring the borders
+     *
+     * @param pose The pose of the wall
+     * @param wall Whether there is a wall
+     */
+    void set_wall(const GridPose& pose, bool wall);
+
+    /**
+     * @brief Checks whether a position is inside the maze
+     *
+     * @param position The position to check
+     * @return True if the position is inside the maze, false otherwise
+     */
+    bool is_inside(const GridPoint& position) const;
+
+    /**
+     * @brief Writes the maze in the text format read by the maze reader
+     *
+     * @param os The output stream
+     */
+    void write_text(std::ostream& os) const;
+
+    /**
+     * @brief Width of the maze in cells
+     */
+    uint8_t width;
+
+    /**
+     * @brief Height of the maze in cells
+     */
+    uint8_t height;
+
+    /**
+     * @brief Whether each cell has a wall on its right side, in row-major order from the bottom
+     */
+    std::vector<uint8_t> east;
+
+    /**
+     * @brief Whether each cell has a wall on its upper side, in row-major order from the bottom
+     */
+    std::vector<uint8_t> north;
+};
+
+/**
+ * @brief Class for generating seeded random mazes
+ *
+ * @details A generator only depends on its seed, so mazes generated in parallel with one generator each are the same
+ *          as when generated in sequence.
+ */
+class MazeGenerator {
+public:
+    /**
+     * @brief Construct a new MazeGenerator object
+     *
+     * @param seed The seed of the random numbers
+     */
+    explicit MazeGenerator(uint64_t seed);
+
+    /**
+     * @brief Generates a maze, whose start cell in the lower left corner is open only upwards, as in contests
+     *
+     * @param algorithm The algorithm used
+     * @param width The width of the maze
+     * @param height The height of the maze
+     * @return The walls of the maze
+     */
+    MazeLayout generate(MazeAlgorithm algorithm, uint8_t width, uint8_t height);
+
+    /**
+     * @brief Generates a maze too large for the grid classes, as a random spanning tree with a few loops
+     *
+     * @param width The width of the maze
+     * @param height The height of the maze
+     * @param loop_fraction The fraction of the walls left by the spanning tree that are opened afterwards
+     * @return The walls of the maze
+     */
+    LargeMaze generate_large(uint16_t width, uint16_t height, float loop_fraction = 0.05F);
+
+    /**
+     * @brief Derives the seed of a maze of a corpus, so that each maze is reproducible on its own
+     *
+     * @param seed The seed of the corpus
+     * @param index The index of the maze in the corpus
+     * @return The seed of the maze
+     */
+    static uint64_t derive_seed(uint64_t seed, uint64_t index);
+
+private:
+    /**
+     * @brief Carves a spanning tree with a depth first search
+     *
+     * @param layout The maze, with every inner wall set
+     */
+    void carve_backtracker(MazeLayout& layout);
+
+    /**
+     * @brief Carves a spanning tree opening the walls in random order, as long as they join separate regions
+     *
+     * @param layout The maze, with every inner wall set
+     * @param regions The region of each cell, with the cells already joined sharing a region
+     * @param walls The walls that may be opened
+     */
+    void carve_kruskal(MazeLayout& layout, std::vector<uint32_t>& regions, std::vector<GridPose>& walls);
+
+    /**
+     * @brief Carves a spanning tree growing from a random cell through random walls of its border
+     *
+     * @param layout The maze, with every inner wall set
+     */
+    void carve_prim(MazeLayout& layout);
+
+    /**
+     * @brief Opens a random wall of every dead end, leading to a neighbour cell
+     *
+     * @param layout The maze
+     */
+    void braid(MazeLayout& layout);
+
+    /**
+     * @brief Generates a contest maze
+     *
+     * @param layout The maze, with every inner wall set
+     */
+    void carve_competition(MazeLayout& layout);
+
+    /**
+     * @brief Closes the right side of the start cell and opens its upper side, joining back through another wall the
+     *        cells that were only reached through the start
+     *
+     * @param layout The maze, with every cell reachable from the start
+     */
+    void open_start(MazeLayout& layout);
+
+    /**
+     * @brief Returns a random number from zero to a bound
+     *
+     * @param bound The bound, excluded
+     * @return The random number
+     */
+    uint32_t random_below(uint32_t bound);
+
+    /**
+     * @brief Source of the random numbers
+     */
+    std::mt19937_64 random;
+};
+
+#endif  // MAZE_GENERATOR_HPP
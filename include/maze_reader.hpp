@@ -0,0 +1,134 @@
+#ifndef MAZE_READER_HPP
+#define MAZE_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hpp"
+
+/**
+ * @brief Type to store the drawing of a maze inside a mapped file
+ */
+struct MazeText {
+    /**
+     * @brief Returns a row of the drawing
+     *
+     * @param row The row of the drawing, counted from the top
+     * @return The characters of the row, without the line ending
+     */
+    std::string_view get_row(std::size_t row) const;
+
+    /**
+     * @brief Name of the file holding the maze
+     */
+    std::string_view source;
+
+    /**
+     * @brief Line of the file where the maze starts, counted from one
+     */
+    std::size_t line;
+
+    /**
+     * @brief Position of the maze among the mazes of its file, counted from zero
+     */
+    std::size_t index;
+
+    /**
+     * @brief Drawing of the maze, starting at its first row
+     */
+    std::string_view data;
+
+    /**
+     * @brief Distance in bytes between the starts of two rows of the drawing
+     */
+    std::size_t stride;
+
+    /**
+     * @brief Width of the maze in cells
+     */
+    uint8_t width;
+
+    /**
+     * @brief Height of the maze in cells
+     */
+    uint8_t height;
+};
+
+/**
+ * @brief Class for reading the mazes of a file or a directory, one after another
+ *
+ * @details The files are memory mapped and read in a single pass. Mazes are separated by blank lines and every
+ *          maze is validated before being returned, reporting the line and column of the first error.
+ */
+class MazeReader {
+public:
+    /**
+     * @brief Construct a new MazeReader object
+     *
+     * @param path A maze file or a directory whose files are read in name order
+     */
+    explicit MazeReader(const std::string& path);
+
+    /**
+     * @brief Reads the next maze
+     *
+     * @param text The drawing of the maze, valid while the reader exists
+     * @return True if a maze was read, false if there are no more mazes
+     */
+    bool next(MazeText& text);
+
+private:
+    /**
+     * @brief Reads a line of the current file
+     *
+     * @param line The contents of the line without its line ending
+     * @return The position after the end of the line
+     */
+    std::size_t read_line(std::string_view& line) const;
+
+    /**
+     * @brief Builds the message of a malformed maze error
+     *
+     * @param line The line of the error, counted from one
+     * @param column The column of the error, counted from one
+     * @param message The description of the error
+     * @return The error message
+     */
+    std::string error(std::size_t line, std::size_t column, const std::string& message) const;
+
+    /**
+     * @brief Names of the files to be read
+     */
+    std::vector<std::string> filenames;
+
+    /**
+     * @brief Files already mapped, kept so that the returned drawings stay valid
+     */
+    std::deque<MappedFile> files;
+
+    /**
+     * @brief Contents of the file being read
+     */
+    std::string_view data;
+
+    /**
+     * @brief Position of the next character of the file being read
+     */
+    std::size_t offset{};
+
+    /**
+     * @brief Line of the next character of the file being read, counted from one
+     */
+    std::size_t line_number{1};
+
+    /**
+     * @brief Number of mazes already read from the file being read
+     */
+    std::size_t maze_count{};
+};
+
+#endif  // MAZE_READER_HPP
@@ -0,0 +1,259 @@
+#ifndef MAZE_RECORD_HPP
+#define MAZE_RECORD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Type to store the fixed size header at the start of every binary maze record
+ *
+ * @details A record is this header followed by the east and north wall planes, each one a row of
+ *          (width + 7) / 8 bytes per maze row from the bottom, with bit x set if the cell at column x has a wall on
+ *          that side. Records with evidence then store two bytes per wall, first the east and then the north
+ *          plane, in row-major order: the signed log-odds of the wall and the number of readings, saturating at 255.
+ *          Version 1 stored the number of wall and free readings instead. All the fields are single bytes, so the
+ *          layout has no padding.
+ */
+struct MazeRecordHeader {
+    /**
+     * @brief Flag set when the record stores the sensor readings about the walls
+     */
+    static constexpr uint8_t has_evidence = 0x01;
+
+    /**
+     * @brief Identification of the format, "MZB"
+     */
+    std::array<char, 3> magic;
+
+    /**
+     * @brief Version of the format
+     */
+    uint8_t version;
+
+    /**
+     * @brief Width of the maze in cells
+     */
+    uint8_t width;
+
+    /**
+     * @brief Height of the maze in cells
+     */
+    uint8_t height;
+
+    /**
+     * @brief Combination of the record flags
+     */
+    uint8_t flags;
+
+    /**
+     * @brief Start orientation of the robot
+     */
+    uint8_t start_orientation;
+
+    /**
+     * @brief Start cell of the robot
+     */
+    GridPoint start_position;
+
+    /**
+     * @brief Lower left cell of the goal region
+     */
+    GridPoint goal_position;
+
+    /**
+     * @brief Width of the goal region in cells
+     */
+    uint8_t goal_width;
+
+    /**
+     * @brief Height of the goal region in cells
+     */
+    uint8_t goal_height;
+
+    /**
+     * @brief Unused bytes, kept at zero
+     */
+    std::array<uint8_t, 2> reserved;
+};
+
+/**
+ * @brief Type to store a binary maze record inside a mapped file, used in place without any parsing
+ */
+struct MazeRecord {
+    /**
+     * @brief Current version of the format
+     */
+    static constexpr uint8_t version = 2;
+
+    /**
+     * @brief Returns the number of bytes of one row of a wall plane
+     *
+     * @param width The width of the maze
+     * @return The number of bytes of the row
+     */
+    static std::size_t get_row_bytes(uint8_t width);
+
+    /**
+     * @brief Returns the size of a record
+     *
+     * @param header The header of the record
+     * @return The size in bytes, header included
+     */
+    static std::size_t get_size(const MazeRecordHeader& header);
+
+    /**
+     * @brief Builds the header of a record, with the format identification already filled
+     *
+     * @param width The width of the maze
+     * @param height The height of the maze
+     * @return The header, with the start at the lower left cell facing up and the central goal region
+     */
+    static MazeRecordHeader make_header(uint8_t width, uint8_t height);
+
+    /**
+     * @brief Returns the walls on the right side of the cells of a row
+     *
+     * @param row The row of the maze
+     * @return The packed bits of the row
+     */
+    std::string_view get_east_row(uint8_t row) const;
+
+    /**
+     * @brief Returns the walls on the upper side of the cells of a row
+     *
+     * @param row The row of the maze
+     * @return The packed bits of the row
+     */
+    std::string_view get_north_row(uint8_t row) const;
+
+    /**
+     * @brief Checks whether there is a wall at the front of a given pose
+     *
+     * @param pose The pose to check
+     * @return True if there is a wall or the pose faces outside the maze, false otherwise
+     */
+    bool has_wall(const GridPose& pose) const;
+
+    /**
+     * @brief Returns the sensor readings about the walls on the right side of each cell
+     *
+     * @return Two bytes per cell in row-major order, empty if the record has no evidence
+     */
+    std::string_view get_east_evidence() const;
+
+    /**
+     * @brief Returns the sensor readings about the walls on the upper side of each cell
+     *
+     * @return Two bytes per cell in row-major order, empty if the record has no evidence
+     */
+    std::string_view get_north_evidence() const;
+
+    /**
+     * @brief Returns the start pose of the robot
+     *
+     * @return The start pose
+     */
+    GridPose get_start() const;
+
+    /**
+     * @brief Name of the file holding the record
+     */
+    std::string_view source;
+
+    /**
+     * @brief Position of the record in its file in bytes
+     */
+    std::size_t offset;
+
+    /**
+     * @brief Position of the record among the records of its file, counted from zero
+     */
+    std::size_t index;
+
+    /**
+     * @brief Header of the record
+     */
+    MazeRecordHeader header;
+
+    /**
+     * @brief Whole record, header included
+     */
+    std::string_view data;
+
+    /**
+     * @brief Width of the maze in cells
+     */
+    uint8_t width;
+
+    /**
+     * @brief Height of the maze in cells
+     */
+    uint8_t height;
+};
+
+/**
+ * @brief Class for reading the binary maze records of a file or a directory, one after another
+ *
+ * @details The files are memory mapped and only the headers are checked, the walls are used in place.
+ */
+class MazeRecordReader {
+public:
+    /**
+     * @brief Construct a new MazeRecordReader object
+     *
+     * @param path A record file or a directory whose files are read in name order
+     */
+    explicit MazeRecordReader(const std::string& path);
+
+    /**
+     * @brief Reads the next record
+     *
+     * @param record The record, valid while the reader exists
+     * @return True if a record was read, false if there are no more records
+     */
+    bool next(MazeRecord& record);
+
+    /**
+     * @brief Checks whether a file or the first file of a directory holds binary records
+     *
+     * @param path A file or a directory
+     * @return True if the file starts with a record header, false otherwise
+     */
+    static bool is_binary(const std::string& path);
+
+private:
+    /**
+     * @brief Names of the files to be read
+     */
+    std::vector<std::string> filenames;
+
+    /**
+     * @brief Files already mapped, kept so that the returned records stay valid
+     */
+    std::deque<MappedFile> files;
+
+    /**
+     * @brief Contents of the file being read
+     */
+    std::string_view data;
+
+    /**
+     * @brief Position of the next record of the file being read
+     */
+    std::size_t offset{};
+
+    /**
+     * @brief Number of records already read from the file being read
+     */
+    std::size_t record_count{};
+};
+
+#endif  // MAZE_RECORD_HPP
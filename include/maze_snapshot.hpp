@@ -0,0 +1,187 @@
+#ifndef MAZE_SNAPSHOT_HPP
+#define MAZE_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cell_mask.hpp"
+#include "costmap.hpp"
+#include "grid_size.hpp"
+#include "known_maze.hpp"
+#include "sensor_model.hpp"
+#include "type.hpp"
+#include "wall_map.hpp"
+
+/**
+ * @brief Class for trying hypothetical walls on a known maze without changing it
+ *
+ * @details The snapshot reads the rows of the known maze it was taken from until a wall of a row is changed, and
+ *          only then copies the evidence and the walls of that row. Copying a snapshot forks it, sharing the rows it
+ *          changed until either fork changes them again, so the memory of a snapshot grows with the rows changed
+ *          instead of the maze size. The known maze must not change while its snapshots are in use, and a snapshot
+ *          reading a known maze whose walls changed since it was taken throws instead of mixing both maps.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class MazeSnapshot : public GridSize<width, height> {
+public:
+    /**
+     * @brief Construct a new MazeSnapshot object, sharing every row with the known maze
+     *
+     * @param base The known maze
+     */
+    explicit MazeSnapshot(const KnownMaze<width, height>& base);
+
+    /**
+     * @brief Adds a hypothetical sensor reading about a wall, weighed as the known maze weighs its readings
+     *
+     * @param pose The pose facing the wall
+     * @param reading The reading of the sensor
+     * @param sensor The sensor giving the reading
+     */
+    void update_wall(const GridPose& pose, Information::Existence reading, Sensor sensor = Sensor::FRONT_SENSOR);
+
+    /**
+     * @brief Sets a hypothetical wall, with the strongest belief allowed
+     *
+     * @param pose The pose facing the wall
+     * @param wall Whether there is a wall
+     */
+    void assume_wall(const GridPose& pose, bool wall);
+
+    /**
+     * @brief Checks whether the snapshot believes there is a wall at the front of a pose
+     *
+     * @param pose The pose to check
+     * @return True if there is a wall or the pose faces outside the maze, false otherwise
+     * @throws std::runtime_error If the walls of the known maze changed since the snapshot was taken
+     */
+    bool has_wall(const GridPose& pose) const;
+
+    /**
+     * @brief Writes the walls believed by the snapshot
+     *
+     * @param walls The wall map to be overwritten
+     * @throws std::runtime_error If the walls of the known maze changed since the snapshot was taken
+     */
+    void get_walls(WallMap<width, height>& walls) const;
+
+    /**
+     * @brief Returns the distance in cells from the start to the goal through the walls believed by the snapshot
+     *
+     * @details The goal costmap of the known maze is copied and repaired, expanding again only the layers affected by
+     *          the walls the snapshot changed.
+     *
+     * @param walls A wall map used for the flood fill, overwritten
+     * @param costmap A costmap used for the flood fill, overwritten
+     * @return The distance of the route, 0xFFFF if the goal is unreachable
+     * @throws std::runtime_error If the walls of the known maze changed since the snapshot was taken
+     */
+    uint16_t get_route_distance(WallMap<width, height>& walls, Costmap<width, height>& costmap) const;
+
+    /**
+     * @brief Returns the number of rows copied from the known maze
+     *
+     * @return The number of rows
+     */
+    uint8_t get_chunk_count() const;
+
+private:
+    /**
+     * @brief Type of the evidence about a wall, shared with the known maze
+     */
+    using Evidence = typename KnownMaze<width, height>::Evidence;
+
+    /**
+     * @brief Type of a row of walls, one bit per cell
+     */
+    using Row = typename CellMask<width, height>::Row;
+
+    /**
+     * @brief Type to store a row of the maze changed by the snapshot
+     */
+    struct Chunk {
+        /**
+         * @brief Evidence about the wall on the right side of each cell of the row
+         */
+        GridBuffer<Evidence, width> east_evidence{};
+
+        /**
+         * @brief Evidence about the wall on the upper side of each cell of the row
+         */
+        GridBuffer<Evidence, width> north_evidence{};
+
+        /**
+         * @brief Whether each cell of the row has a wall on its right side
+         */
+        Row east_walls{};
+
+        /**
+         * @brief Whether each cell of the row has a wall on its upper side
+         */
+        Row north_walls{};
+    };
+
+    /**
+     * @brief Value of the rows still shared with the known maze
+     */
+    static constexpr uint8_t shared = 0xFF;
+
+    /**
+     * @brief Checks that the walls of the known maze did not change since the snapshot was taken
+     */
+    void check_base() const;
+
+    /**
+     * @brief Returns the copy of a row to be changed, copying it from the known maze the first time and from the
+     *        other forks sharing it afterwards
+     *
+     * @param row The row of the maze
+     * @return The copy of the row
+     */
+    Chunk& get_chunk(uint8_t row);
+
+    /**
+     * @brief Calls a function for every wall the snapshot believes differently from the known maze
+     *
+     * @param function The function, taking the pose facing the wall and whether the snapshot believes there is a wall
+     */
+    template <typename Function>
+    void for_each_change(Function&& function) const;
+
+    /**
+     * @brief Changes the evidence about a wall and sets the wall from its new belief
+     *
+     * @param pose The pose facing the wall
+     * @param change The change of the evidence
+     */
+    template <typename Change>
+    void change_wall(const GridPose& pose, Change change);
+
+    /**
+     * @brief Known maze the snapshot was taken from
+     */
+    const KnownMaze<width, height>* base;
+
+    /**
+     * @brief Version of the map of the known maze when the snapshot was taken
+     */
+    uint32_t base_version;
+
+    /**
+     * @brief Index of the copy of each row, shared for the rows read from the known maze
+     */
+    GridBuffer<uint8_t, height> row_chunks{};
+
+    /**
+     * @brief Copies of the rows changed by the snapshot, shared with its forks until changed again
+     */
+    std::vector<std::shared_ptr<Chunk>> chunks;
+};
+
+#include "../src/maze_snapshot.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // MAZE_SNAPSHOT_HPP
@@ -2,27 +2,208 @@
 #define MICRAS_HPP
 
 #include <cstdint>
-#include <ostream>
 
+#include "grid_size.hpp"
 #include "known_maze.hpp"
+#include "maze_record.hpp"
+#include "route_planner.hpp"
+#include "sensor_model.hpp"
+#include "trace.hpp"
 #include "type.hpp"
 
+/**
+ * @brief Type to store a motion primitive of the robot, turning in place and then driving straight through cells
+ */
+struct Motion {
+    /**
+     * @brief Orientation of the straight run
+     */
+    Side orientation{};
+
+    /**
+     * @brief Number of turns in place before the straight run, a half turn counting as one
+     */
+    uint8_t turns{};
+
+    /**
+     * @brief Number of cells of the straight run
+     */
+    uint16_t cells{};
+};
+
 template <std::uint8_t width, std::uint8_t height>
 class Micras {
 public:
-    Micras(const GridPose& start);
+    Micras(const GridPose& start, const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Puts the robot back at the start of an unknown maze of the same size, keeping its memory
+     *
+     * @param start The start pose of the robot
+     */
+    void reset(const GridPose& start);
+
+    /**
+     * @brief Puts the robot at the start of a maze it already knows, restoring its memory from a binary record
+     *
+     * @param record The record saved by the known maze in a previous run
+     */
+    void load(const MazeRecord& record);
+
+    /**
+     * @brief Updates the map with the readings of the sensors and moves to the next cell or turns towards it
+     *
+     * @details Each step extends the motion primitive being driven, a turn after a straight run, a collision or a slip
+     *          starting a new one, so the motion controller can keep driving straight while the map is updated.
+     *
+     * @param information The information from the distance sensors
+     * @return The motion primitive the step is part of
+     */
+    const Motion& step(const Information& information);
 
-    void step(const Information& information);
+    /**
+     * @brief Puts the robot back in the cell it left, after its last move failed by going through a wall it believed
+     *        open or by slipping
+     */
+    void bump();
 
     const GridPose& get_pose() const;
 
-    template <std::uint8_t w, std::uint8_t h>
-    friend std::ostream& operator<<(std::ostream& os, const Micras<w, h>& micras);
+    /**
+     * @brief Returns the number of cells the robot drove straight through since it last updated its map
+     *
+     * @return The number of cells, zero if the map was updated in the last step
+     */
+    uint16_t get_straight_run() const;
+
+    /**
+     * @brief Returns the maze known by the robot
+     *
+     * @return The known maze
+     */
+    const KnownMaze<width, height>& get_known_maze() const;
+
+    /**
+     * @brief Returns the estimated time of the route planned for the fast runs
+     *
+     * @return The time in seconds, zero if no route was planned
+     */
+    float get_route_time() const;
+
+    /**
+     * @brief Sets the planner of the time optimal route followed by the fast runs instead of the flood fill route
+     *
+     * @details The planner is owned by the caller, so a robot without one does not pay for its search buffers.
+     *
+     * @param planner The planner, with the size of the maze, null to follow the flood fill route
+     */
+    void set_route_planner(RoutePlanner<width, height>* planner);
+
+    /**
+     * @brief Sets how the robot explores the maze before the fast runs
+     *
+     * @param strategy The exploration strategy
+     */
+    void set_exploration_strategy(ExplorationStrategy strategy);
+
+    /**
+     * @brief Sets whether the known maze repairs its costmaps after wall changes instead of recomputing them
+     *
+     * @param incremental True to repair only the cells affected by the changed walls, false to recompute everything
+     */
+    void set_incremental_costmap(bool incremental);
+
+    /**
+     * @brief Sets how much the robot trusts the readings of each sensor
+     *
+     * @param model The model of the sensors of the robot
+     */
+    void set_sensor_model(const SensorModel& model);
+
+    /**
+     * @brief Sets the cells the robot must reach, kept across resets
+     *
+     * @param goal The goal cells, at least one
+     */
+    void set_goal(const CellMask<width, height>& goal);
+
+    /**
+     * @brief Sets a rectangle of cells as the goal, kept across resets
+     *
+     * @param position The lower left cell of the rectangle
+     * @param goal_width The width of the rectangle in cells
+     * @param goal_height The height of the rectangle in cells
+     */
+    void set_goal(const GridPoint& position, uint8_t goal_width, uint8_t goal_height);
+
+    /**
+     * @brief Sets the trace receiving the steps of the robot, starting with its next reset
+     *
+     * @param trace The trace, null to stop tracing
+     * @param run_id The identification written in the run records
+     */
+    void set_trace(TraceWriter* trace, uint32_t run_id = 0);
 
 private:
+    /**
+     * @brief Returns the next cell the robot should go to
+     *
+     * @return The next cell
+     */
+    GridPoint get_current_goal();
+
+    /**
+     * @brief Checks whether the robot can drive straight through its cell without updating its map, as the readings
+     *        bring no news and it would keep going straight anyway
+     *
+     * @param information The information from the distance sensors in the cell
+     * @return True if the robot can drive through the cell, false otherwise
+     */
+    bool can_drive_through(const Information& information) const;
+
     GridPose pose;
 
     KnownMaze<width, height> known_maze;
+
+    /**
+     * @brief Planner of the fastest route, used once the exploration is over, null to follow the flood fill route
+     */
+    RoutePlanner<width, height>* route_planner{};
+
+    /**
+     * @brief Whether the fastest route was already planned after the exploration
+     */
+    bool route_planned{};
+
+    /**
+     * @brief Whether the route planner found a route to the goal
+     */
+    bool route_found{};
+
+    /**
+     * @brief Whether the sensor model of the robot is noisy
+     */
+    bool noisy_sensors{};
+
+    /**
+     * @brief Number of cells driven straight through since the last update of the map
+     */
+    uint16_t straight_run{};
+
+    /**
+     * @brief Motion primitive being driven, empty after a reset or a bump
+     */
+    Motion motion{};
+
+    /**
+     * @brief Trace receiving the steps of the robot, null if they are not traced
+     */
+    TraceWriter* trace{};
+
+    /**
+     * @brief Identification written in the run records
+     */
+    uint32_t run_id{};
 };
 
 #include "../src/micras.cpp"
@@ -0,0 +1,82 @@
+#ifndef NEIGHBOR_TABLE_HPP
+#define NEIGHBOR_TABLE_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "grid_size.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Class for looking up the index of the neighbors of every cell, with a sentinel for the ones off the grid
+ *
+ * @details The table of a size fixed at compile time is computed by the compiler and shared by every object, so
+ *          it takes no memory in the objects. Runtime sizes build their own table.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class NeighborTable : public GridSize<width, height> {
+public:
+    /**
+     * @brief Index returned for the neighbors off the grid
+     */
+    static constexpr uint16_t off_grid = 0xFFFF;
+
+    /**
+     * @brief Construct a new NeighborTable object
+     *
+     * @param size The size of the maze
+     */
+    explicit constexpr NeighborTable(const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Returns the index of the neighbor of a cell
+     *
+     * @param cell_index The index of the cell, which must be inside the maze
+     * @param side The side of the neighbor
+     * @return The index of the neighbor, off_grid if it is outside the maze
+     */
+    constexpr uint16_t get_neighbor(uint16_t cell_index, Side side) const;
+
+private:
+    /**
+     * @brief Computes the index of the neighbor of a cell
+     *
+     * @param size The size of the maze
+     * @param cell_index The index of the cell
+     * @param side The side of the neighbor
+     * @return The index of the neighbor, off_grid if it is outside the maze
+     */
+    static constexpr uint16_t compute_neighbor(const GridSize<width, height>& size, uint16_t cell_index, Side side);
+
+    /**
+     * @brief Computes the table of a size fixed at compile time
+     *
+     * @return The neighbors of every cell, indexed by cell and then by side, empty if the size is dynamic
+     */
+    static constexpr std::array<uint16_t, 4 * width * height> build_fixed();
+
+    /**
+     * @brief Type taking no space, stored instead of the table of a size fixed at compile time
+     */
+    struct Fixed { };
+
+    /**
+     * @brief Neighbors of every cell of a size fixed at compile time, indexed by cell and then by side
+     */
+    static constexpr std::array<uint16_t, 4 * width * height> fixed_neighbors = build_fixed();
+
+    /**
+     * @brief Neighbors of every cell of a runtime size, indexed by cell and then by side
+     */
+    [[no_unique_address]] std::conditional_t<GridSize<width, height>::dynamic, std::vector<uint16_t>, Fixed>
+        neighbors{};
+};
+
+#include "../src/neighbor_table.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // NEIGHBOR_TABLE_HPP
@@ -0,0 +1,198 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Quantities measured by the profiler, the times in cycle counter ticks and the others in their own units
+ */
+enum ProfileMetric : uint8_t {
+    STEP_TIME = 0,
+    MAZE_UPDATE_TIME,
+    WALL_UPDATE_TIME,
+    COSTMAP_TIME,
+    BEST_ROUTE_TIME,
+    EXPLORATION_TIME,
+    CURRENT_GOAL_TIME,
+    ROUTE_PLAN_TIME,
+    FLOOD_FILL_CELLS,
+    FLOOD_FILL_QUEUE,
+    COSTMAP_RESETS,
+    COSTMAP_REPAIRS,
+    SKIPPED_REPAIRS,
+    SKIPPED_ROUTES,
+    SKIPPED_PROOFS,
+    WALL_FLIPS,
+    BEST_ROUTE_LENGTH,
+    ROUTE_PLAN_EXPANSIONS,
+    METRIC_COUNT
+};
+
+/**
+ * @brief Type to store the samples of a metric
+ */
+struct ProfileStatistic {
+    /**
+     * @brief Number of samples
+     */
+    uint64_t count;
+
+    /**
+     * @brief Sum of the samples
+     */
+    uint64_t total;
+
+    /**
+     * @brief Largest sample
+     */
+    uint64_t maximum;
+};
+
+/**
+ * @brief Type to store the metrics gathered by every thread, ready to be written
+ */
+struct ProfileReport {
+    /**
+     * @brief Writes the report as a JSON object, with the times in nanoseconds
+     *
+     * @param os The output stream
+     */
+    void write_json(std::ostream& os) const;
+
+    /**
+     * @brief Writes the report as a table, with the times in microseconds
+     *
+     * @param os The output stream
+     */
+    void write_table(std::ostream& os) const;
+
+    /**
+     * @brief Samples of each metric
+     */
+    std::array<ProfileStatistic, METRIC_COUNT> statistics;
+
+    /**
+     * @brief Measured rate of the cycle counter, used to turn the ticks into time
+     */
+    double ticks_per_second;
+};
+
+/**
+ * @brief Class for gathering the metrics of the calling thread
+ *
+ * @details Each thread owns a profiler, so recording a sample needs no synchronization. The metrics of a thread are
+ *          added to the shared totals when it exits. The profiler is only used through the macros below, which
+ *          expand to nothing unless the project is configured with PROFILING=ON.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Whether the profiling macros were compiled in
+     */
+#ifdef PROFILING_ENABLED
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    /**
+     * @brief Destroy the Profiler object, adding its metrics to the shared totals
+     */
+    ~Profiler();
+
+    /**
+     * @brief Returns the profiler of the calling thread
+     *
+     * @return The profiler
+     */
+    static Profiler& get();
+
+    /**
+     * @brief Records a sample of a metric
+     *
+     * @param metric The metric
+     * @param value The value of the sample
+     */
+    void add(ProfileMetric metric, uint64_t value);
+
+    /**
+     * @brief Gathers the metrics of the threads that already exited and of the calling thread
+     *
+     * @return The report of the metrics
+     */
+    static ProfileReport collect();
+
+    /**
+     * @brief Clears the metrics of the threads that already exited and of the calling thread
+     */
+    static void clear();
+
+    /**
+     * @brief Reads the cycle counter of the processor, or a nanosecond clock where there is none
+     *
+     * @return The current tick count
+     */
+    static uint64_t read_ticks();
+
+private:
+    /**
+     * @brief Samples of each metric recorded by the thread
+     */
+    std::array<ProfileStatistic, METRIC_COUNT> statistics{};
+};
+
+/**
+ * @brief Class for timing a scope, recording its ticks when it ends
+ */
+class ProfileTimer {
+public:
+    /**
+     * @brief Construct a new ProfileTimer object, starting the timer
+     *
+     * @param metric The metric receiving the time
+     */
+    explicit ProfileTimer(ProfileMetric metric);
+
+    /**
+     * @brief Destroy the ProfileTimer object, recording the time
+     */
+    ~ProfileTimer();
+
+    ProfileTimer(const ProfileTimer&) = delete;
+    ProfileTimer& operator=(const ProfileTimer&) = delete;
+    ProfileTimer(ProfileTimer&&) = delete;
+    ProfileTimer& operator=(ProfileTimer&&) = delete;
+
+private:
+    /**
+     * @brief Metric receiving the time
+     */
+    ProfileMetric metric;
+
+    /**
+     * @brief Tick count at the start of the scope
+     */
+    uint64_t start;
+};
+
+/**
+ * @brief Times the rest of the enclosing scope, at most once per scope
+ */
+#ifdef PROFILING_ENABLED
+#define PROFILE_SCOPE(metric) const ProfileTimer profile_timer(ProfileMetric::metric)
+#else
+#define PROFILE_SCOPE(metric) static_cast<void>(0)
+#endif
+
+/**
+ * @brief Records a sample of a metric, without evaluating the value when profiling is disabled
+ */
+#ifdef PROFILING_ENABLED
+#define PROFILE_SAMPLE(metric, value) Profiler::get().add(ProfileMetric::metric, value)
+#else
+#define PROFILE_SAMPLE(metric, value) static_cast<void>(0)
+#endif
+
+#endif  // PROFILER_HPP
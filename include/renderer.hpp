@@ -0,0 +1,138 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "grid_size.hpp"
+#include "known_maze.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Class for drawing the maze known by the robot on a terminal
+ *
+ * @details Each frame is rendered into a preallocated buffer with one glyph per cell, wall and post of the maze.
+ *          Only the glyphs that differ from the previous frame are written, placed with ANSI cursor moves, so the
+ *          cost of a frame follows what changed instead of the size of the maze.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class Renderer : public GridSize<width, height> {
+public:
+    /**
+     * @brief Construct a new Renderer object
+     *
+     * @param size The size of the maze
+     * @param frame_rate The maximum number of frames drawn per second, zero to draw every frame
+     */
+    explicit Renderer(const GridSize<width, height>& size = {}, float frame_rate = 0.0F);
+
+    /**
+     * @brief Draws the changes since the previous frame, clearing the terminal on the first one
+     *
+     * @param os The output stream, expected to be a terminal
+     * @param maze The maze known by the robot
+     * @param pose The pose of the robot
+     * @param force Whether to draw even if the frame rate limit was reached
+     * @return True if the frame was drawn, false if it was skipped by the frame rate limit
+     */
+    bool draw(std::ostream& os, const KnownMaze<width, height>& maze, const GridPose& pose, bool force = false);
+
+    /**
+     * @brief Writes a whole frame as plain text, without any cursor moves
+     *
+     * @param os The output stream
+     * @param maze The maze known by the robot
+     * @param pose The pose of the robot
+     */
+    void write(std::ostream& os, const KnownMaze<width, height>& maze, const GridPose& pose);
+
+    /**
+     * @brief Forgets the previous frame, so the next one is drawn from scratch
+     */
+    void invalidate();
+
+private:
+    /**
+     * @brief Type to store the UTF-8 text of a glyph two columns wide, padded with zeros
+     */
+    using Glyph = std::array<char, 8>;
+
+    /**
+     * @brief Number of glyphs of a frame, zero for a runtime size
+     */
+    static constexpr uint32_t frame_size = GridSize<width, height>::dynamic ? 0 : (2 * width + 1) * (2 * height + 1);
+
+    /**
+     * @brief Renders a frame into the current buffer
+     *
+     * @param maze The maze known by the robot
+     * @param pose The pose of the robot
+     */
+    void render(const KnownMaze<width, height>& maze, const GridPose& pose);
+
+    /**
+     * @brief Returns the glyph of a cell
+     *
+     * @param maze The maze known by the robot
+     * @param pose The pose of the robot
+     * @param position The position of the cell
+     * @return The glyph of the cell
+     */
+    static Glyph cell_glyph(const KnownMaze<width, height>& maze, const GridPose& pose, const GridPoint& position);
+
+    /**
+     * @brief Appends an ANSI cursor move to the output buffer
+     *
+     * @param row The terminal row, counted from zero
+     * @param column The terminal column, counted from zero
+     */
+    void move_cursor(std::size_t row, std::size_t column);
+
+    /**
+     * @brief Appends a glyph to the output buffer
+     *
+     * @param glyph The glyph to be appended
+     */
+    void append(const Glyph& glyph);
+
+    /**
+     * @brief Glyphs of the frame being drawn, row-major from the top left corner
+     */
+    GridBuffer<Glyph, frame_size> frame{};
+
+    /**
+     * @brief Glyphs of the previous frame drawn
+     */
+    GridBuffer<Glyph, frame_size> previous_frame{};
+
+    /**
+     * @brief Whether the previous frame is on the terminal
+     */
+    bool has_previous_frame{};
+
+    /**
+     * @brief Text written to the stream, kept to reuse its memory
+     */
+    std::string output;
+
+    /**
+     * @brief Minimum time between two frames
+     */
+    std::chrono::steady_clock::duration frame_period{};
+
+    /**
+     * @brief Time when the previous frame was drawn
+     */
+    std::chrono::steady_clock::time_point last_frame_time;
+};
+
+#include "../src/renderer.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // RENDERER_HPP
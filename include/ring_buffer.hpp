@@ -0,0 +1,89 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Lock free queue of fixed capacity between one producer thread and one consumer thread
+ *
+ * @details Each side keeps a copy of the index owned by the other one and only reloads it when the queue looks full
+ *          or empty, so in the common case pushing and popping touch no shared cache line.
+ *
+ * @tparam T The type of the items, copied in and out of the queue
+ */
+template <typename T>
+class RingBuffer {
+public:
+    /**
+     * @brief Construct a new RingBuffer object
+     *
+     * @param capacity The minimum number of items held, rounded up to a power of two
+     */
+    explicit RingBuffer(std::size_t capacity);
+
+    /**
+     * @brief Adds an item to the queue, called only by the producer
+     *
+     * @param item The item to be added
+     * @return True if the item was added, false if the queue is full
+     */
+    bool push(const T& item);
+
+    /**
+     * @brief Removes the oldest items of the queue, called only by the consumer
+     *
+     * @param items The array receiving the items
+     * @param count The maximum number of items to be removed
+     * @return The number of items removed
+     */
+    std::size_t pop(T* items, std::size_t count);
+
+    /**
+     * @brief Returns the number of items the queue can hold
+     *
+     * @return The capacity of the queue
+     */
+    std::size_t get_capacity() const;
+
+private:
+    /**
+     * @brief Size of a cache line, used to keep the indices of each side apart
+     */
+    static constexpr std::size_t cache_line_size = 64;
+
+    /**
+     * @brief Storage of the items
+     */
+    std::vector<T> items;
+
+    /**
+     * @brief Mask turning an index into a position of the storage
+     */
+    std::size_t mask;
+
+    /**
+     * @brief Number of items ever added, written by the producer
+     */
+    alignas(cache_line_size) std::atomic<std::size_t> head{};
+
+    /**
+     * @brief Last number of removed items seen by the producer
+     */
+    std::size_t cached_tail{};
+
+    /**
+     * @brief Number of items ever removed, written by the consumer
+     */
+    alignas(cache_line_size) std::atomic<std::size_t> tail{};
+
+    /**
+     * @brief Last number of added items seen by the consumer
+     */
+    std::size_t cached_head{};
+};
+
+#include "../src/ring_buffer.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // RING_BUFFER_HPP
@@ -0,0 +1,211 @@
+#ifndef ROUTE_PLANNER_HPP
+#define ROUTE_PLANNER_HPP
+
+#include <cstdint>
+
+#include "cell_mask.hpp"
+#include "grid_size.hpp"
+#include "indexed_heap.hpp"
+#include "type.hpp"
+#include "wall_map.hpp"
+
+/**
+ * @brief Type to store the motion capabilities of the robot used to estimate run times
+ */
+struct MotionProfile {
+    /**
+     * @brief Size of a cell of the maze in meters
+     */
+    float cell_size{0.18F};
+
+    /**
+     * @brief Maximum speed on straight runs in m/s
+     */
+    float max_speed{2.0F};
+
+    /**
+     * @brief Maximum speed on diagonal runs in m/s
+     */
+    float max_diagonal_speed{1.4F};
+
+    /**
+     * @brief Linear acceleration and deceleration in m/s²
+     */
+    float acceleration{5.0F};
+
+    /**
+     * @brief Speed at the start and end of every run, where the turns happen, in m/s
+     */
+    float turn_speed{0.6F};
+
+    /**
+     * @brief Time of a 90 degrees turn in seconds
+     */
+    float turn_time{0.25F};
+
+    /**
+     * @brief Time of a 45 degrees turn entering or leaving a diagonal in seconds
+     */
+    float diagonal_turn_time{0.15F};
+};
+
+/**
+ * @brief Class for planning the fastest route to the goal over the known walls
+ *
+ * @details The states are the poses of the robot at the center of the cells. Straight runs, zig-zag runs taken
+ *          as diagonals and 90 degrees turns are single edges, so their acceleration is accounted for without
+ *          storing the run length in the state.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class RoutePlanner : public GridSize<width, height> {
+public:
+    /**
+     * @brief Construct a new RoutePlanner object
+     *
+     * @param profile The motion profile used to estimate the run times
+     * @param size The size of the maze
+     */
+    explicit RoutePlanner(const MotionProfile& profile = {}, const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Plans the fastest route from a pose to the goal
+     *
+     * @param walls The walls to be avoided
+     * @param start The pose where the route starts
+     * @param goal The cells where the route may end
+     * @return True if a route was found, false otherwise
+     */
+    bool plan(const WallMap<width, height>& walls, const GridPose& start, const CellMask<width, height>& goal);
+
+    /**
+     * @brief Returns the next cell of the planned route
+     *
+     * @param position The current position of the robot
+     * @return The next cell of the route, or the same position if it is not on the route or at its end
+     */
+    GridPoint get_next(const GridPoint& position) const;
+
+    /**
+     * @brief Returns the estimated time of the planned route
+     *
+     * @return The time in seconds
+     */
+    float get_time() const;
+
+    /**
+     * @brief Sets the motion profile used to estimate the run times
+     *
+     * @param profile The new motion profile
+     */
+    void set_profile(const MotionProfile& profile);
+
+private:
+    /**
+     * @brief Number of states of the search, one for each cell and orientation, zero if the size is dynamic
+     */
+    static constexpr uint32_t state_count = 4U * width * height;
+
+    /**
+     * @brief Type used to identify a state
+     */
+    using State = IndexedHeap<state_count>::Index;
+
+    /**
+     * @brief Type to store how a state was reached
+     */
+    struct Edge {
+        State    parent;
+        uint16_t length;
+        Side     first_move;
+    };
+
+    /**
+     * @brief Tries to reach a state with a lower time
+     *
+     * @param parent The state from which the edge leaves
+     * @param pose The pose reached by the edge
+     * @param time The time when the pose is reached
+     * @param length The number of cells moved by the edge
+     * @param first_move The first move of the edge, alternating with the parent orientation
+     */
+    void relax(State parent, const GridPose& pose, float time, uint16_t length, Side first_move);
+
+    /**
+     * @brief Rebuilds the route walking the edges back from the last state
+     *
+     * @param last The state where the route ends
+     */
+    void build_route(State last);
+
+    /**
+     * @brief Estimates the time of a run starting and ending at the turn speed
+     *
+     * @param distance The distance of the run in meters
+     * @param max_speed The maximum speed of the run in m/s
+     * @return The time of the run in seconds
+     */
+    float run_time(float distance, float max_speed) const;
+
+    /**
+     * @brief Returns the state of a pose
+     *
+     * @param pose The pose of the robot
+     * @return The state of the pose
+     */
+    State state(const GridPose& pose) const;
+
+    /**
+     * @brief Returns the pose of a state
+     *
+     * @param state The state of the search
+     * @return The pose of the state
+     */
+    GridPose pose(State state) const;
+
+    /**
+     * @brief Motion profile used to estimate the run times
+     */
+    MotionProfile profile;
+
+    /**
+     * @brief Queue of the states to be expanded
+     */
+    IndexedHeap<state_count> queue;
+
+    /**
+     * @brief Lowest time found to reach each state
+     */
+    GridBuffer<float, state_count> times{};
+
+    /**
+     * @brief Edge through which each state was reached with the lowest time
+     */
+    GridBuffer<Edge, state_count> edges{};
+
+    /**
+     * @brief Cells of the planned route, indexed by step from the start
+     */
+    GridBuffer<GridPoint, width * height> route{};
+
+    /**
+     * @brief Number of cells in the planned route
+     */
+    uint16_t route_length{};
+
+    /**
+     * @brief Step of each cell in the planned route, 0xFFFF if the cell is not on it
+     */
+    GridBuffer<uint16_t, width * height> route_step{};
+
+    /**
+     * @brief Estimated time of the planned route
+     */
+    float route_time{};
+};
+
+#include "../src/route_planner.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // ROUTE_PLANNER_HPP
@@ -0,0 +1,131 @@
+#ifndef SENSOR_MODEL_HPP
+#define SENSOR_MODEL_HPP
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "type.hpp"
+
+/**
+ * @brief Possible distance sensors, in the order of the readings of the information
+ */
+enum Sensor : uint8_t {
+    LEFT_SENSOR = 0,
+    FRONT_LEFT_SENSOR = 1,
+    FRONT_SENSOR = 2,
+    FRONT_RIGHT_SENSOR = 3,
+    RIGHT_SENSOR = 4
+};
+
+/**
+ * @brief Type to store the probabilities of a sensor reading the wrong value
+ */
+struct SensorNoise {
+    /**
+     * @brief Probability of reading a wall where there is none
+     */
+    float false_positive{};
+
+    /**
+     * @brief Probability of reading no wall where there is one
+     */
+    float false_negative{};
+};
+
+/**
+ * @brief Returns a random number from zero to one, the same on every platform for a given seed
+ *
+ * @param random The source of random numbers
+ * @return The random number, one excluded
+ */
+double random_unit(std::mt19937_64& random);
+
+/**
+ * @brief Class for describing how unreliable the distance sensors are
+ *
+ * @details The simulation uses the model to corrupt the readings of the maze, and the known maze uses it to weigh the
+ *          readings it receives. The default model is perfect.
+ */
+class SensorModel {
+public:
+    /**
+     * @brief Number of distance sensors
+     */
+    static constexpr uint8_t sensor_count = 5;
+
+    /**
+     * @brief Construct a new perfect SensorModel object
+     */
+    SensorModel() = default;
+
+    /**
+     * @brief Construct a new SensorModel object with the same noise in every sensor
+     *
+     * @param noise The noise of the walls next to the robot
+     * @param range_noise The probability added to both errors for each cell between the robot and the wall
+     */
+    explicit SensorModel(const SensorNoise& noise, float range_noise = 0.0F);
+
+    /**
+     * @brief Builds a model from its text, as given in the command line
+     *
+     * @param text The false positive and false negative rates and the optional range noise, separated by commas
+     * @return The sensor model
+     */
+    static SensorModel parse(const std::string& text);
+
+    /**
+     * @brief Sets the noise of a sensor for the walls next to the robot
+     *
+     * @param sensor The sensor
+     * @param noise The noise of the sensor
+     */
+    void set_noise(Sensor sensor, const SensorNoise& noise);
+
+    /**
+     * @brief Returns the noise of a sensor, including the noise of its range
+     *
+     * @param sensor The sensor
+     * @return The noise of the sensor, with probabilities up to one half
+     */
+    SensorNoise get_noise(Sensor sensor) const;
+
+    /**
+     * @brief Returns the number of cells between the robot and the wall seen by a sensor
+     *
+     * @param sensor The sensor
+     * @return The range of the sensor in cells
+     */
+    static uint8_t get_range(Sensor sensor);
+
+    /**
+     * @brief Checks whether no sensor ever reads the wrong value
+     *
+     * @return True if the model is perfect, false otherwise
+     */
+    bool is_perfect() const;
+
+    /**
+     * @brief Corrupts the readings of perfect sensors, leaving the unknown ones untouched
+     *
+     * @param information The perfect readings
+     * @param random The source of random numbers, owned by the caller so runs can be reproduced
+     * @return The noisy readings
+     */
+    Information apply(const Information& information, std::mt19937_64& random) const;
+
+private:
+    /**
+     * @brief Noise of each sensor for the walls next to the robot
+     */
+    std::array<SensorNoise, sensor_count> noise{};
+
+    /**
+     * @brief Probability added to both errors for each cell between the robot and the wall
+     */
+    float range_noise{};
+};
+
+#endif  // SENSOR_MODEL_HPP
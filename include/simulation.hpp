@@ -0,0 +1,197 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <cstdint>
+#include <random>
+
+#include "grid_size.hpp"
+#include "maze.hpp"
+#include "micras.hpp"
+#include "sensor_model.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Type to store the outcome of a simulated run
+ */
+struct EpisodeResult {
+    /**
+     * @brief Total number of steps taken
+     */
+    uint32_t steps{};
+
+    /**
+     * @brief Steps taken exploring the maze, going to the goal and returning to the start
+     */
+    uint32_t exploration_steps{};
+
+    /**
+     * @brief Exploration steps in which the robot updated its map, the others driving straight through known cells
+     */
+    uint32_t map_updates{};
+
+    /**
+     * @brief Motion primitives driven in all the steps, each turning in place and then driving straight
+     */
+    uint32_t motions{};
+
+    /**
+     * @brief Steps taken in the fast run from the start to the goal
+     */
+    uint32_t fast_run_steps{};
+
+    /**
+     * @brief Flood fill cost from the start to the goal over the explored maze
+     */
+    uint16_t route_cost{};
+
+    /**
+     * @brief Estimated time of the fast run route in seconds
+     */
+    float route_time{};
+
+    /**
+     * @brief Number of moves through walls the robot believed open, after which it was put back
+     */
+    uint32_t collisions{};
+
+    /**
+     * @brief Number of moves lost to slipping wheels, after which the robot moved again
+     */
+    uint32_t slips{};
+
+    /**
+     * @brief Whether the exploration proved that no unseen wall can make the route shorter
+     */
+    bool route_proven{};
+
+    /**
+     * @brief Whether the fast run was stopped by hitting a wall on its route
+     */
+    bool route_blocked{};
+
+    /**
+     * @brief Whether the fast run reached the goal within the step limit
+     */
+    bool finished{};
+
+    /**
+     * @brief Whether the run was stopped because the robot kept the same pose for too many steps in a row
+     */
+    bool stuck{};
+
+    /**
+     * @brief Pose in which the robot got stuck
+     */
+    GridPose stuck_pose{};
+};
+
+/**
+ * @brief Class for running the robot through mazes without any user interaction
+ *
+ * @details The robot is reset before each run, so its memory is reused across the mazes of a corpus.
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class Simulation {
+public:
+    /**
+     * @brief Number of steps in a row in the same pose after which the robot is stuck, far more than repeated
+     *        collisions or slips would take with any sensible noise
+     */
+    static constexpr uint32_t stuck_steps = 64;
+
+    /**
+     * @brief Construct a new Simulation object
+     *
+     * @param start The starting pose of the robot
+     * @param size The size of the mazes
+     */
+    explicit Simulation(const GridPose& start, const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Runs the explore, return and fast run cycle in a maze
+     *
+     * @param maze The maze to be solved, with the size given at construction
+     * @param max_steps The maximum number of steps before giving up
+     * @return The outcome of the run
+     */
+    EpisodeResult run(const Maze<width, height>& maze, uint32_t max_steps);
+
+    /**
+     * @brief Sets the noise of the simulated sensors, which the robot also uses to weigh its readings
+     *
+     * @param model The sensor model
+     */
+    void set_sensor_model(const SensorModel& model);
+
+    /**
+     * @brief Sets the probability of a move failing because the wheels slipped, leaving the robot in its cell
+     *
+     * @param probability The probability of each move slipping
+     */
+    void set_slip_probability(float probability);
+
+    /**
+     * @brief Sets whether the fast runs of the robot follow the time optimal route, planned in the buffers of the
+     *        simulation, instead of the flood fill route
+     *
+     * @param enabled Whether to use the route planner
+     */
+    void set_route_planner(bool enabled);
+
+    /**
+     * @brief Seeds the random numbers of the noise and the slips, so a run can be reproduced
+     *
+     * @param seed The seed
+     */
+    void set_seed(uint64_t seed);
+
+    /**
+     * @brief Returns the simulated robot
+     *
+     * @return The robot
+     */
+    Micras<width, height>& get_micras();
+
+private:
+    /**
+     * @brief Starting pose of the robot
+     */
+    GridPose start;
+
+    /**
+     * @brief Simulated robot
+     */
+    Micras<width, height> micras;
+
+    /**
+     * @brief Planner lent to the robot for its fast runs
+     */
+    RoutePlanner<width, height> route_planner;
+
+    /**
+     * @brief Whether the robot uses the route planner
+     */
+    bool use_route_planner{true};
+
+    /**
+     * @brief Noise of the simulated sensors
+     */
+    SensorModel sensor_model;
+
+    /**
+     * @brief Probability of each move slipping
+     */
+    float slip_probability{};
+
+    /**
+     * @brief Source of the random numbers of the noise and the slips
+     */
+    std::mt19937_64 random;
+};
+
+#include "../src/simulation.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // SIMULATION_HPP
@@ -0,0 +1,133 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool of worker threads with one task queue per worker and work stealing between them
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Construct a new ThreadPool object
+     *
+     * @param thread_count The number of worker threads, zero to use one per hardware thread
+     */
+    explicit ThreadPool(std::size_t thread_count = 0);
+
+    /**
+     * @brief Destroy the ThreadPool object, waiting for the queued tasks to finish
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Queues a task, distributing the tasks among the workers in turn
+     *
+     * @param task The task to be run
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads
+     *
+     * @return The number of worker threads
+     */
+    std::size_t get_thread_count() const;
+
+    /**
+     * @brief Returns the index of the worker running the calling thread
+     *
+     * @return The index of the worker, or the thread count if called from outside the pool
+     */
+    std::size_t get_worker_index() const;
+
+private:
+    /**
+     * @brief Type to store the task queue of a worker
+     */
+    struct Worker {
+        std::deque<std::function<void()>> tasks;
+        std::mutex                        mutex;
+    };
+
+    /**
+     * @brief Main loop of a worker thread
+     *
+     * @param index The index of the worker
+     */
+    void run(std::size_t index);
+
+    /**
+     * @brief Takes a task from the back of the worker queue or, if it is empty, from the front of another one
+     *
+     * @param index The index of the worker
+     * @param task The task taken
+     * @return True if a task was taken, false otherwise
+     */
+    bool take_task(std::size_t index, std::function<void()>& task);
+
+    /**
+     * @brief Task queues, one for each worker
+     */
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /**
+     * @brief Worker threads
+     */
+    std::vector<std::thread> threads;
+
+    /**
+     * @brief Mutex protecting the sleep and wake up of the workers
+     */
+    std::mutex state_mutex;
+
+    /**
+     * @brief Condition signaled when a task is queued or the pool is stopping
+     */
+    std::condition_variable task_available;
+
+    /**
+     * @brief Condition signaled when every task has finished
+     */
+    std::condition_variable all_done;
+
+    /**
+     * @brief Number of tasks queued and not yet taken
+     */
+    std::atomic<std::size_t> queued_count{};
+
+    /**
+     * @brief Number of tasks submitted and not yet finished
+     */
+    std::atomic<std::size_t> pending_count{};
+
+    /**
+     * @brief Worker that receives the next submitted task
+     */
+    std::atomic<std::size_t> next_worker{};
+
+    /**
+     * @brief Whether the workers should exit
+     */
+    bool stopping{};
+};
+
+#endif  // THREAD_POOL_HPP
@@ -0,0 +1,327 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "mapped_file.hpp"
+#include "ring_buffer.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Possible types of the records of a trace
+ */
+enum TraceRecordType : uint8_t {
+    RUN = 1,
+    STEP = 2
+};
+
+/**
+ * @brief Type to store the record written when the robot starts a run, before the records of its steps
+ *
+ * @details All the multi byte fields are aligned, so the layout has no padding.
+ */
+struct TraceRun {
+    /**
+     * @brief Flag set when the fast runs follow the route planner
+     */
+    static constexpr uint8_t route_planner = 0x01;
+
+    /**
+     * @brief Flag set when the robot weighs its readings with a noisy sensor model, which the replay must be given
+     */
+    static constexpr uint8_t noisy_sensors = 0x02;
+
+    /**
+     * @brief Type of the record, always RUN
+     */
+    TraceRecordType type;
+
+    /**
+     * @brief Width of the maze in cells
+     */
+    uint8_t width;
+
+    /**
+     * @brief Height of the maze in cells
+     */
+    uint8_t height;
+
+    /**
+     * @brief Start pose of the robot
+     */
+    GridPose start;
+
+    /**
+     * @brief Exploration strategy of the robot
+     */
+    uint8_t strategy;
+
+    /**
+     * @brief Combination of the run flags
+     */
+    uint8_t flags;
+
+    /**
+     * @brief Lower left cell of the bounding box of the goal
+     */
+    GridPoint goal_position;
+
+    /**
+     * @brief Width of the bounding box of the goal in cells
+     */
+    uint8_t goal_width;
+
+    /**
+     * @brief Height of the bounding box of the goal in cells
+     */
+    uint8_t goal_height;
+
+    /**
+     * @brief Identification of the run given by the caller, such as the index of the maze in a corpus
+     */
+    uint32_t id;
+};
+
+/**
+ * @brief Type to store the record written after each step of the robot
+ */
+struct TraceStep {
+    /**
+     * @brief Flag set when the robot was exploring after the step
+     */
+    static constexpr uint8_t exploring = 0x01;
+
+    /**
+     * @brief Flag set when the robot was returning to the start after the step
+     */
+    static constexpr uint8_t returning = 0x02;
+
+    /**
+     * @brief Flag set when the move of the robot failed, hitting a wall it believed open or slipping, and it was put
+     *        back in the cell it left, the goal being that cell
+     */
+    static constexpr uint8_t bumped = 0x04;
+
+    /**
+     * @brief Flag set when the robot drove straight through a cell it already knew, recording the readings without
+     *        updating its map
+     */
+    static constexpr uint8_t driven_through = 0x08;
+
+    /**
+     * @brief Type of the record, always STEP
+     */
+    TraceRecordType type;
+
+    /**
+     * @brief Combination of the step flags
+     */
+    uint8_t flags;
+
+    /**
+     * @brief Pose of the robot before the step
+     */
+    GridPose pose;
+
+    /**
+     * @brief Cell chosen as the next goal of the robot
+     */
+    GridPoint goal;
+
+    /**
+     * @brief Sensor readings received by the step
+     */
+    Information information;
+
+    /**
+     * @brief Time spent updating the known maze and its costmaps, in nanoseconds
+     */
+    uint32_t update_time;
+};
+
+/**
+ * @brief Type to store any record of a trace, told apart by the type that starts both of them
+ */
+union TraceRecord {
+    TraceRun  run;
+    TraceStep step;
+};
+
+/**
+ * @brief Class for writing a binary trace of the runs of the robot without slowing it down
+ *
+ * @details The records are queued in a lock free ring buffer and a background thread writes them to the file. A
+ *          trace is a file header followed by fixed size records, one run record followed by the records of its
+ *          steps. When the buffer is full the robot waits for the writer instead of losing records, since a trace
+ *          with gaps could not be replayed.
+ */
+class TraceWriter {
+public:
+    /**
+     * @brief Construct a new TraceWriter object, creating the file and starting the writer thread
+     *
+     * @param filename The name of the trace file
+     * @param capacity The number of records the buffer holds
+     */
+    explicit TraceWriter(const std::string& filename, std::size_t capacity = 1 << 16);
+
+    /**
+     * @brief Destroy the TraceWriter object, writing the queued records and closing the file unless it was closed
+     *
+     * @note Write errors are only reported by close, as a destructor must not throw
+     */
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+    TraceWriter(TraceWriter&&) = delete;
+    TraceWriter& operator=(TraceWriter&&) = delete;
+
+    /**
+     * @brief Queues the record of the start of a run
+     *
+     * @param run The run record
+     */
+    void write(const TraceRun& run);
+
+    /**
+     * @brief Queues the record of a step
+     *
+     * @param step The step record
+     */
+    void write(const TraceStep& step);
+
+    /**
+     * @brief Returns the number of times a record waited for room in the buffer
+     *
+     * @return The number of waits
+     */
+    uint64_t get_stall_count() const;
+
+    /**
+     * @brief Writes the queued records, stops the writer thread and closes the file
+     *
+     * @throws std::runtime_error If the records could not be written to the file
+     */
+    void close();
+
+private:
+    /**
+     * @brief Stops the writer thread once the queued records are written, unless it was already stopped
+     */
+    void stop();
+
+    /**
+     * @brief Queues a record, waiting while the buffer is full
+     *
+     * @param record The record to be queued
+     */
+    void push(const TraceRecord& record);
+
+    /**
+     * @brief Main loop of the writer thread
+     */
+    void run();
+
+    /**
+     * @brief Name of the trace file
+     */
+    std::string filename;
+
+    /**
+     * @brief Trace file
+     */
+    std::ofstream file;
+
+    /**
+     * @brief Records queued and not yet written
+     */
+    RingBuffer<TraceRecord> buffer;
+
+    /**
+     * @brief Number of times a record waited for room in the buffer
+     */
+    uint64_t stall_count{};
+
+    /**
+     * @brief Whether a write to the file failed, set by the writer thread and read once it exited
+     */
+    bool write_failed{};
+
+    /**
+     * @brief Whether the writer thread should exit once the buffer is empty
+     */
+    std::atomic<bool> stopping{};
+
+    /**
+     * @brief Writer thread
+     */
+    std::thread writer;
+};
+
+/**
+ * @brief Class for reading the records of a trace file, one after another
+ */
+class TraceReader {
+public:
+    /**
+     * @brief Construct a new TraceReader object, mapping the file and checking its header
+     *
+     * @param filename The name of the trace file
+     */
+    explicit TraceReader(const std::string& filename);
+
+    /**
+     * @brief Reads the next record
+     *
+     * @param record The record
+     * @return True if a record was read, false if there are no more records
+     */
+    bool next(TraceRecord& record);
+
+    /**
+     * @brief Returns the position of the next record in the file
+     *
+     * @return The position in bytes
+     */
+    std::size_t get_offset() const;
+
+private:
+    /**
+     * @brief Name of the trace file
+     */
+    std::string filename;
+
+    /**
+     * @brief Mapped trace file
+     */
+    MappedFile file;
+
+    /**
+     * @brief Contents of the trace file
+     */
+    std::string_view data;
+
+    /**
+     * @brief Position of the next record in the file
+     */
+    std::size_t offset{};
+};
+
+/**
+ * @brief Returns the nanoseconds of a duration, saturated to fit a trace record
+ *
+ * @param duration The duration
+ * @return The duration in nanoseconds
+ */
+uint32_t trace_time(std::chrono::steady_clock::duration duration);
+
+#endif  // TRACE_HPP
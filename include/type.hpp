@@ -1,6 +1,7 @@
 #ifndef TYPE_HPP
 #define TYPE_HPP
 
+#include <array>
 #include <cstdint>
 #include <functional>
 
@@ -55,7 +56,7 @@ struct GridPoint {
      * @param next The next point
      * @return The direction from this point to the next one
      */
-    Side direction(const GridPoint& next) const;
+    constexpr Side direction(const GridPoint& next) const;
 
     /**
      * @brief Moves in the grid in the direction of the side
@@ -63,7 +64,7 @@ struct GridPoint {
      * @param side The side to move to
      * @return The new point after moving
      */
-    GridPoint operator+(const Side& side) const;
+    constexpr GridPoint operator+(const Side& side) const;
 
     /**
      * @brief Compares two points for equality
@@ -71,7 +72,7 @@ struct GridPoint {
      * @param other The other point to compare
      * @return True if the points are equal, false otherwise
      */
-    bool operator==(const GridPoint& other) const;
+    constexpr bool operator==(const GridPoint& other) const;
 
     /**
      * @brief The x coordinate of the point on the grid
@@ -90,28 +91,28 @@ struct GridPose {
      *
      * @return The pose after moving forward
      */
-    GridPose front() const;
+    constexpr GridPose front() const;
 
     /**
      * @brief Returns the pose after turning back
      *
      * @return The pose after turning back
      */
-    GridPose turned_back() const;
+    constexpr GridPose turned_back() const;
 
     /**
      * @brief Returns the pose after turning left
      *
      * @return The pose after turning left
      */
-    GridPose turned_left() const;
+    constexpr GridPose turned_left() const;
 
     /**
      * @brief Returns the pose after turning right
      *
      * @return The pose after turning right
      */
-    GridPose turned_right() const;
+    constexpr GridPose turned_right() const;
 
     /**
      * @brief Compares two poses for equality
@@ -119,7 +120,7 @@ struct GridPose {
      * @param other The other pose to compare
      * @return True if the poses are equal, false otherwise
      */
-    bool operator==(const GridPose& other) const;
+    constexpr bool operator==(const GridPose& other) const;
 
     /**
      * @brief The position of the pose on the grid
@@ -132,6 +133,59 @@ struct GridPose {
     Side orientation;
 };
 
+// Defined in the header so the flood fills inline them and the grid tables can be computed at compile time
+constexpr Side GridPoint::direction(const GridPoint& next) const {
+    if (next.x > this->x) {
+        return Side::RIGHT;
+    }
+
+    if (next.y > this->y) {
+        return Side::UP;
+    }
+
+    if (next.x < this->x) {
+        return Side::LEFT;
+    }
+
+    if (next.y < this->y) {
+        return Side::DOWN;
+    }
+
+    return Side::UP;
+}
+
+constexpr GridPoint GridPoint::operator+(const Side& side) const {
+    constexpr std::array<int8_t, 4> x_steps = {1, 0, -1, 0};
+    constexpr std::array<int8_t, 4> y_steps = {0, 1, 0, -1};
+
+    // Moving off the bottom or left border wraps around to 255, which the grid classes treat as outside the maze
+    return {static_cast<uint8_t>(this->x + x_steps[side]), static_cast<uint8_t>(this->y + y_steps[side])};
+}
+
+constexpr bool GridPoint::operator==(const GridPoint& other) const {
+    return this->x == other.x and this->y == other.y;
+}
+
+constexpr GridPose GridPose::front() const {
+    return {this->position + this->orientation, this->orientation};
+}
+
+constexpr GridPose GridPose::turned_back() const {
+    return {this->position, static_cast<Side>((this->orientation + 2) % 4)};
+}
+
+constexpr GridPose GridPose::turned_left() const {
+    return {this->position, static_cast<Side>((this->orientation + 1) % 4)};
+}
+
+constexpr GridPose GridPose::turned_right() const {
+    return {this->position, static_cast<Side>((this->orientation + 3) % 4)};
+}
+
+constexpr bool GridPose::operator==(const GridPose& other) const {
+    return this->position == other.position and this->orientation == other.orientation;
+}
+
 namespace std {
 /**
  * @brief Hash specialization for the GridPoint type
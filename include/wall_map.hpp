@@ -0,0 +1,129 @@
+#ifndef WALL_MAP_HPP
+#define WALL_MAP_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#include "cell_mask.hpp"
+#include "grid_size.hpp"
+#include "maze_record.hpp"
+#include "type.hpp"
+
+/**
+ * @brief Class for storing the walls of a maze as bit planes, with one bit per wall shared by both cells
+ *
+ * @tparam width The width of the maze, zero for a runtime size
+ * @tparam height The height of the maze, zero for a runtime size
+ */
+template <uint8_t width, uint8_t height>
+class WallMap : public GridSize<width, height> {
+public:
+    /**
+     * @brief Type to store one row of walls, one bit per cell
+     */
+    using Row = CellMask<width, height>::Row;
+
+    /**
+     * @brief Construct a new WallMap object with only the border walls
+     *
+     * @param size The size of the maze
+     */
+    explicit WallMap(const GridSize<width, height>& size = {});
+
+    /**
+     * @brief Removes every wall except the border ones
+     */
+    void reset();
+
+    /**
+     * @brief Copies the wall planes of a binary record, which must have the same size as the map
+     *
+     * @param record The record to be loaded
+     */
+    void load(const MazeRecord& record);
+
+    /**
+     * @brief Writes the wall planes in the layout of a binary record
+     *
+     * @param os The output stream
+     */
+    void save(std::ostream& os) const;
+
+    /**
+     * @brief Checks whether there is a wall at the front of a given pose
+     *
+     * @param pose The pose to check
+     * @return True if there is a wall, false otherwise
+     */
+    bool has_wall(const GridPose& pose) const;
+
+    /**
+     * @brief Returns the walls around a cell inside the maze
+     *
+     * @param position The position of the cell
+     * @return One bit per side, indexed by the side, set if there is a wall on that side
+     */
+    uint8_t get_walls(const GridPoint& position) const;
+
+    /**
+     * @brief Sets the existence of the wall at the front of a given pose
+     *
+     * @note The border walls can not be removed, so setting them is ignored
+     *
+     * @param pose The pose to set
+     * @param wall Whether there is a wall
+     */
+    void set_wall(const GridPose& pose, bool wall);
+
+    /**
+     * @brief Returns the walls on the right side of the cells of a row
+     *
+     * @param row The row of the maze
+     * @return The walls of the row as a bit mask
+     */
+    const Row& get_east_walls(uint8_t row) const;
+
+    /**
+     * @brief Returns the walls on the upper side of the cells of a row
+     *
+     * @param row The row of the maze
+     * @return The walls of the row as a bit mask
+     */
+    const Row& get_north_walls(uint8_t row) const;
+
+    /**
+     * @brief Returns the pose facing right or up that refers to the same wall as the given one
+     *
+     * @param pose The pose to normalize
+     * @return The equivalent pose, outside the grid if the wall is on the left or lower border
+     */
+    static GridPose normalized(const GridPose& pose);
+
+    /**
+     * @brief Checks whether the wall at the front of a given pose is part of the maze border
+     *
+     * @param pose The pose to check
+     * @return True if the wall is on the border, false otherwise
+     */
+    bool is_border(const GridPose& pose) const;
+
+private:
+    /**
+     * @brief Adds the walls of the maze border
+     */
+    void add_borders();
+
+    /**
+     * @brief Walls on the right side of each cell
+     */
+    CellMask<width, height> east_walls;
+
+    /**
+     * @brief Walls on the upper side of each cell
+     */
+    CellMask<width, height> north_walls;
+};
+
+#include "../src/wall_map.cpp"  // NOLINT(bugprone-suspicious-include, misc-header-include-cycle)
+
+#endif  // WALL_MAP_HPP
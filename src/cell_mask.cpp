@@ -0,0 +1,127 @@
+#ifndef CELL_MASK_CPP
+#define CELL_MASK_CPP
+
+#include <algorithm>
+#include <bit>
+
+#include "cell_mask.hpp"
+
+template <uint8_t width, uint8_t height>
+constexpr CellMask<width, height>::CellMask(const GridSize<width, height>& size) : GridSize<width, height>(size) {
+    fill_buffer(this->rows, this->get_height(), Row{});
+}
+
+template <uint8_t width, uint8_t height>
+constexpr bool CellMask<width, height>::contains(const GridPoint& position) const {
+    return (this->rows[position.y][position.x / 64] >> (position.x % 64)) & 1U;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr void CellMask<width, height>::set(const GridPoint& position, bool value) {
+    uint64_t mask = uint64_t{1} << (position.x % 64);
+
+    if (value) {
+        this->rows[position.y][position.x / 64] |= mask;
+    } else {
+        this->rows[position.y][position.x / 64] &= ~mask;
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr void CellMask<width, height>::clear() {
+    std::fill(this->rows.begin(), this->rows.end(), Row{});
+}
+
+template <uint8_t width, uint8_t height>
+constexpr const CellMask<width, height>::Row& CellMask<width, height>::get_row(uint8_t row) const {
+    return this->rows[row];
+}
+
+template <uint8_t width, uint8_t height>
+constexpr CellMask<width, height>::Row& CellMask<width, height>::get_row(uint8_t row) {
+    return this->rows[row];
+}
+
+template <uint8_t width, uint8_t height>
+template <typename Function>
+constexpr void CellMask<width, height>::for_each(Function&& function) const {
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        for (uint8_t word = 0; word < row_words; word++) {
+            for (uint64_t bits = this->rows[row][word]; bits != 0; bits &= bits - 1) {
+                function(GridPoint{static_cast<uint8_t>(word * 64 + std::countr_zero(bits)), row});
+            }
+        }
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr bool CellMask<width, height>::empty() const {
+    for (const auto& row : this->rows) {
+        for (const auto& word : row) {
+            if (word != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr std::pair<GridPoint, GridPoint> CellMask<width, height>::get_bounds() const {
+    GridPoint lower_left{this->get_width(), this->get_height()};
+    GridPoint upper_right{};
+
+    this->for_each([&](const GridPoint& position) {
+        lower_left = {std::min(lower_left.x, position.x), std::min(lower_left.y, position.y)};
+        upper_right = {std::max(upper_right.x, position.x), std::max(upper_right.y, position.y)};
+    });
+
+    return {lower_left, upper_right};
+}
+
+template <uint8_t width, uint8_t height>
+constexpr CellMask<width, height>& CellMask<width, height>::operator|=(const CellMask& other) {
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        for (uint8_t word = 0; word < row_words; word++) {
+            this->rows[row][word] |= other.rows[row][word];
+        }
+    }
+
+    return *this;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr CellMask<width, height>::Row CellMask<width, height>::shifted_east(const Row& row) {
+    Row shifted{};
+
+    for (uint8_t word = 0; word < row_words; word++) {
+        shifted[word] = (row[word] << 1U) | (word > 0 ? row[word - 1] >> 63U : 0);
+    }
+
+    return shifted;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr CellMask<width, height>::Row CellMask<width, height>::shifted_west(const Row& row) {
+    Row shifted{};
+
+    for (uint8_t word = 0; word < row_words; word++) {
+        shifted[word] = (row[word] >> 1U) | (word + 1 < row_words ? row[word + 1] << 63U : 0);
+    }
+
+    return shifted;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr CellMask<width, height>::Row CellMask<width, height>::without(const Row& row, const Row& mask) {
+    Row masked{};
+
+    for (uint8_t word = 0; word < row_words; word++) {
+        masked[word] = row[word] & ~mask[word];
+    }
+
+    return masked;
+}
+
+#endif  // CELL_MASK_CPP
@@ -0,0 +1,284 @@
+#ifndef COSTMAP_CPP
+#define COSTMAP_CPP
+
+#include <algorithm>
+#include <bit>
+
+#include "costmap.hpp"
+#include "profiler.hpp"
+
+template <uint8_t width, uint8_t height>
+Costmap<width, height>::Costmap(const GridSize<width, height>& size) :
+    GridSize<width, height>(size), neighbors(size) {
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+    this->reached = CellMask<width, height>(size);
+    this->frontier = CellMask<width, height>(size);
+    this->next = CellMask<width, height>(size);
+    fill_buffer(this->ranks, this->get_cell_count(), uint16_t{0});
+#endif
+
+    fill_buffer(this->costs, this->get_cell_count(), uint16_t{0xFFFF});
+    fill_buffer(this->distances, this->get_cell_count(), uint16_t{0xFFFF});
+    fill_buffer(this->origins, this->get_cell_count(), Side::RIGHT);
+    fill_buffer(this->visit_order, this->get_cell_count(), GridPoint{});
+}
+
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::reset(const WallMap<width, height>& walls, const CellMask<width, height>& seeds) {
+    std::fill(this->costs.begin(), this->costs.end(), 0xFFFF);
+    std::fill(this->distances.begin(), this->distances.end(), 0xFFFF);
+    this->visited_count = 0;
+    this->dirty_layer = 0xFFFF;
+
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+    this->reached = seeds;
+#endif
+
+    PROFILE_SAMPLE(COSTMAP_RESETS, 1);
+
+    seeds.for_each([this](const GridPoint& position) {
+        this->costs[this->index(position)] = 0;
+        this->distances[this->index(position)] = 0;
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+        this->ranks[this->index(position)] = this->visited_count;
+#endif
+        this->visit_order[this->visited_count++] = position;
+    });
+
+    this->propagate(walls, 0);
+}
+
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::invalidate(const GridPose& pose) {
+    GridPoint front_position = pose.front().position;
+
+    if (not this->is_inside(pose.position) or not this->is_inside(front_position)) {
+        return;
+    }
+
+    uint16_t distance = this->distances[this->index(pose.position)];
+    uint16_t front_distance = this->distances[this->index(front_position)];
+
+    // Walls between cells of the same layer are never crossed by the flood fill
+    if (distance != front_distance) {
+        this->dirty_layer = std::min({this->dirty_layer, distance, front_distance});
+    }
+}
+
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::repair(const WallMap<width, height>& walls) {
+    if (this->dirty_layer == 0xFFFF) {
+        PROFILE_SAMPLE(SKIPPED_REPAIRS, 1);
+        return;
+    }
+
+    PROFILE_SAMPLE(COSTMAP_REPAIRS, 1);
+    this->rewind(walls, this->dirty_layer);
+    this->dirty_layer = 0xFFFF;
+}
+
+template <uint8_t width, uint8_t height>
+uint16_t Costmap<width, height>::get_cost(const GridPoint& position) const {
+    return this->costs.at(this->index(position));
+}
+
+template <uint8_t width, uint8_t height>
+uint16_t Costmap<width, height>::get_distance(const GridPoint& position) const {
+    return this->distances.at(this->index(position));
+}
+
+template <uint8_t width, uint8_t height>
+Side Costmap<width, height>::get_origin(const GridPoint& position) const {
+    return this->origins.at(this->index(position));
+}
+
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::rewind(const WallMap<width, height>& walls, uint16_t layer) {
+    auto visited_end = this->visit_order.begin() + this->visited_count;
+
+    // The visit order is sorted by distance, so every layer is a contiguous range of it
+    auto layer_begin = std::partition_point(this->visit_order.begin(), visited_end, [this, layer](const GridPoint& p) {
+        return this->distances[this->index(p)] < layer;
+    });
+    auto layer_end = std::partition_point(layer_begin, visited_end, [this, layer](const GridPoint& p) {
+        return this->distances[this->index(p)] == layer;
+    });
+
+    // Costs are cleared as well, as the cells cut off by the new walls are not reached again
+    for (auto position = layer_end; position != visited_end; position++) {
+        this->distances[this->index(*position)] = 0xFFFF;
+        this->costs[this->index(*position)] = 0xFFFF;
+
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+        this->reached.set(*position, false);
+#endif
+    }
+
+    this->visited_count = std::distance(this->visit_order.begin(), layer_end);
+    this->propagate(walls, std::distance(this->visit_order.begin(), layer_begin));
+}
+
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::propagate(const WallMap<width, height>& walls, uint16_t head) {
+    using Mask = CellMask<width, height>;
+
+    uint8_t low_row = this->get_height();
+    uint8_t high_row = 0;
+
+    // The queue of the wavefront is the layer being expanded
+    [[maybe_unused]] uint16_t first_visited = head;
+    [[maybe_unused]] uint16_t queue_length = this->visited_count - head;
+
+    this->frontier.clear();
+
+    for (uint16_t i = head; i < this->visited_count; i++) {
+        this->frontier.set(this->visit_order[i]);
+        low_row = std::min(low_row, this->visit_order[i].y);
+        high_row = std::max(high_row, this->visit_order[i].y);
+    }
+
+    // Only the rows between the frontier bounds are scanned, as the frontier moves at most one row per layer
+    while (low_row <= high_row) {
+        this->next.clear();
+
+        for (uint8_t row = low_row; row <= high_row; row++) {
+            const auto& parents = this->frontier.get_row(row);
+            const auto& east_walls = walls.get_east_walls(row);
+            const auto& north_walls = walls.get_north_walls(row);
+
+            this->relax_row(Mask::shifted_east(Mask::without(parents, east_walls)), row, Side::RIGHT);
+            this->relax_row(Mask::without(Mask::shifted_west(parents), east_walls), row, Side::LEFT);
+
+            if (row + 1 < this->get_height()) {
+                this->relax_row(Mask::without(parents, north_walls), row + 1, Side::UP);
+            }
+
+            if (row > 0) {
+                this->relax_row(Mask::without(parents, walls.get_north_walls(row - 1)), row - 1, Side::DOWN);
+            }
+        }
+
+        uint16_t layer_start = this->visited_count;
+        uint8_t  first_row = low_row > 0 ? low_row - 1 : 0;
+        uint8_t  last_row = std::min<uint8_t>(high_row + 1, this->get_height() - 1);
+        low_row = this->get_height();
+        high_row = 0;
+
+        for (uint8_t row = first_row; row <= last_row; row++) {
+            const auto& cells = this->next.get_row(row);
+            auto&       reached_cells = this->reached.get_row(row);
+
+            for (uint8_t word = 0; word < Mask::row_words; word++) {
+                reached_cells[word] |= cells[word];
+            }
+        }
+
+        // The queue visits the children of each parent in the side order, so the layer is listed the same way
+        for (; head < layer_start; head++) {
+            GridPoint parent_position = this->visit_order[head];
+            uint16_t  parent_index = this->index(parent_position);
+
+            for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+                Side     side = static_cast<Side>(i);
+                uint16_t cell_index = this->neighbors.get_neighbor(parent_index, side);
+
+                // A cell of the layer is listed by the parent it was reached from
+                if (cell_index == NeighborTable<width, height>::off_grid or this->origins[cell_index] != side or
+                    this->distances[cell_index] != this->distances[parent_index] + 1) {
+                    continue;
+                }
+
+                GridPoint position = parent_position + side;
+                this->ranks[cell_index] = this->visited_count;
+                this->visit_order[this->visited_count++] = position;
+                low_row = std::min(low_row, position.y);
+                high_row = std::max(high_row, position.y);
+            }
+        }
+
+        queue_length = std::max<uint16_t>(queue_length, this->visited_count - layer_start);
+
+        std::swap(this->frontier, this->next);
+    }
+
+    PROFILE_SAMPLE(FLOOD_FILL_CELLS, this->visited_count - first_visited);
+    PROFILE_SAMPLE(FLOOD_FILL_QUEUE, queue_length);
+}
+
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::relax_row(const CellMask<width, height>::Row& candidates, uint8_t row, Side side) {
+    auto children = CellMask<width, height>::without(candidates, this->reached.get_row(row));
+
+    for (uint8_t word = 0; word < CellMask<width, height>::row_words; word++) {
+        for (uint64_t bits = children[word]; bits != 0; bits &= bits - 1) {
+            GridPoint position{static_cast<uint8_t>(word * 64 + std::countr_zero(bits)), row};
+            uint16_t  cell_index = this->index(position);
+            uint16_t  parent_index = this->neighbors.get_neighbor(cell_index, static_cast<Side>((side + 2) % 4));
+
+            if (this->relax(cell_index, parent_index, side)) {
+                this->next.set(position);
+            }
+        }
+    }
+}
+#else
+template <uint8_t width, uint8_t height>
+void Costmap<width, height>::propagate(const WallMap<width, height>& walls, uint16_t head) {
+    // Only read by the profiler, so they are optimized away when it is disabled
+    [[maybe_unused]] uint16_t first_visited = head;
+    [[maybe_unused]] uint16_t queue_length = 0;
+
+    while (head < this->visited_count) {
+        queue_length = std::max<uint16_t>(queue_length, this->visited_count - head);
+        GridPoint current_position = this->visit_order[head++];
+        uint16_t  current_index = this->index(current_position);
+        uint8_t   cell_walls = walls.get_walls(current_position);
+
+        for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+            Side     side = static_cast<Side>(i);
+            uint16_t front_index = this->neighbors.get_neighbor(current_index, side);
+
+            if (((cell_walls >> side) & 1U) or front_index == NeighborTable<width, height>::off_grid) {
+                continue;
+            }
+
+            if (this->relax(front_index, current_index, side)) {
+                this->visit_order[this->visited_count++] = current_position + side;
+            }
+        }
+    }
+
+    PROFILE_SAMPLE(FLOOD_FILL_CELLS, this->visited_count - first_visited);
+    PROFILE_SAMPLE(FLOOD_FILL_QUEUE, queue_length);
+}
+#endif
+
+template <uint8_t width, uint8_t height>
+bool Costmap<width, height>::relax(uint16_t cell_index, uint16_t parent_index, Side side) {
+    bool reached = this->distances[cell_index] != 0xFFFF;
+    bool claimed = not reached;
+
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+    // The whole layer is relaxed at once, so a cell reached twice in it goes to the parent first in the visit order,
+    // the one the queue would have dequeued first
+    if (reached) {
+        Side back = static_cast<Side>((this->origins[cell_index] + 2) % 4);
+        claimed = this->ranks[parent_index] < this->ranks[this->neighbors.get_neighbor(cell_index, back)];
+    }
+#endif
+
+    if (not claimed) {
+        return false;
+    }
+
+    // Seeds have no origin, so leaving them never counts as a turn
+    bool straight = this->distances[parent_index] == 0 or side == this->origins[parent_index];
+
+    this->distances[cell_index] = this->distances[parent_index] + 1;
+    this->costs[cell_index] = this->costs[parent_index] + (straight ? 1 : 2);
+    this->origins[cell_index] = side;
+    return not reached;
+}
+
+#endif  // COSTMAP_CPP
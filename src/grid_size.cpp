@@ -0,0 +1,57 @@
+#ifndef GRID_SIZE_CPP
+#define GRID_SIZE_CPP
+
+#include <algorithm>
+
+#include "grid_size.hpp"
+
+template <typename Buffer, typename T>
+constexpr void fill_buffer(Buffer& buffer, std::size_t count, const T& value) {
+    if constexpr (requires { buffer.assign(count, value); }) {
+        buffer.assign(count, value);
+    } else {
+        std::fill(buffer.begin(), buffer.end(), value);
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr GridSize<width, height>::GridSize(uint8_t runtime_width, uint8_t runtime_height) {
+    if constexpr (dynamic) {
+        this->dimensions = {runtime_width, runtime_height};
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr uint8_t GridSize<width, height>::get_width() const {
+    if constexpr (dynamic) {
+        return this->dimensions[0];
+    } else {
+        return width;
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr uint8_t GridSize<width, height>::get_height() const {
+    if constexpr (dynamic) {
+        return this->dimensions[1];
+    } else {
+        return height;
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr uint16_t GridSize<width, height>::get_cell_count() const {
+    return this->get_width() * this->get_height();
+}
+
+template <uint8_t width, uint8_t height>
+constexpr uint16_t GridSize<width, height>::index(const GridPoint& position) const {
+    return position.y * this->get_width() + position.x;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr bool GridSize<width, height>::is_inside(const GridPoint& position) const {
+    return position.x < this->get_width() and position.y < this->get_height();
+}
+
+#endif  // GRID_SIZE_CPP
@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "hierarchical_planner.hpp"
+
+HierarchicalPlanner::HierarchicalPlanner(uint8_t cluster_size) : cluster_size(cluster_size) {
+    if (cluster_size == 0) {
+        throw std::runtime_error("Clusters must have at least one cell per side");
+    }
+
+    this->cluster_distances.resize(cluster_size * cluster_size);
+    this->cluster_queue.resize(cluster_size * cluster_size);
+}
+
+void HierarchicalPlanner::build(const LargeMaze& maze) {
+    this->cluster_columns = (maze.get_width() + this->cluster_size - 1) / this->cluster_size;
+    uint32_t cluster_rows = (maze.get_height() + this->cluster_size - 1) / this->cluster_size;
+
+    this->portals.clear();
+    this->links.clear();
+    this->cluster_portals.assign(this->cluster_columns * cluster_rows, {});
+
+    // Each border is scanned from the cluster below or to its left, which adds the portals of both sides
+    for (uint32_t cluster = 0; cluster < this->cluster_portals.size(); cluster++) {
+        LargePoint first{
+            static_cast<uint16_t>(cluster % this->cluster_columns * this->cluster_size),
+            static_cast<uint16_t>(cluster / this->cluster_columns * this->cluster_size)
+        };
+        auto cluster_width = static_cast<uint16_t>(std::min<int>(this->cluster_size, maze.get_width() - first.x));
+        auto cluster_height = static_cast<uint16_t>(std::min<int>(this->cluster_size, maze.get_height() - first.y));
+
+        if (first.x + cluster_width < maze.get_width()) {
+            LargePoint border{static_cast<uint16_t>(first.x + cluster_width - 1), first.y};
+            this->add_portals(maze, border, cluster_height, Side::RIGHT);
+        }
+
+        if (first.y + cluster_height < maze.get_height()) {
+            LargePoint border{first.x, static_cast<uint16_t>(first.y + cluster_height - 1)};
+            this->add_portals(maze, border, cluster_width, Side::UP);
+        }
+    }
+
+    for (const auto& cluster : this->cluster_portals) {
+        for (uint32_t portal : cluster) {
+            this->search_cluster(maze, this->portals[portal].position);
+
+            for (uint32_t other : cluster) {
+                uint32_t distance = this->get_cluster_distance(this->portals[other].position);
+
+                if (other != portal and distance != unreachable) {
+                    this->links[portal].push_back({other, distance});
+                }
+            }
+        }
+    }
+
+    this->costs.assign(this->portals.size() + 1, unreachable);
+    this->parents.assign(this->portals.size() + 1, unreachable);
+    this->goal_distances.assign(this->portals.size(), unreachable);
+    this->heap = IndexedHeap<0>(this->portals.size() + 1);
+    this->add_landmarks(maze);
+}
+
+uint32_t HierarchicalPlanner::plan(const LargeMaze& maze, const LargePoint& start, const LargePoint& goal) {
+    if (not maze.is_inside(start) or not maze.is_inside(goal)) {
+        throw std::runtime_error("The ends of the route must be inside the maze");
+    }
+
+    auto     goal_node = static_cast<uint32_t>(this->portals.size());
+    uint32_t start_cluster = this->get_cluster(start);
+    uint32_t goal_cluster = this->get_cluster(goal);
+
+    std::fill(this->costs.begin(), this->costs.end(), unreachable);
+    this->heap.clear();
+    this->route.clear();
+
+    this->search_cluster(maze, goal);
+    this->goal_landmark_distances.fill(unreachable);
+
+    for (uint32_t portal : this->cluster_portals[goal_cluster]) {
+        this->goal_distances[portal] = this->get_cluster_distance(this->portals[portal].position);
+
+        for (uint8_t landmark = 0; landmark < landmark_count and this->goal_distances[portal] != unreachable;
+             landmark++) {
+            uint32_t distance = this->landmark_distances[portal * landmark_count + landmark];
+
+            if (distance != unreachable) {
+                this->goal_landmark_distances[landmark] =
+                    std::min(this->goal_landmark_distances[landmark], distance + this->goal_distances[portal]);
+            }
+        }
+    }
+
+    this->search_cluster(maze, start);
+
+    // A route inside the start cluster may still be longer than one leaving it, so it only seeds the search
+    if (start_cluster == goal_cluster and this->get_cluster_distance(goal) != unreachable) {
+        this->costs[goal_node] = this->get_cluster_distance(goal);
+        this->parents[goal_node] = unreachable;
+        this->heap.push(goal_node, static_cast<float>(this->costs[goal_node]));
+    }
+
+    for (uint32_t portal : this->cluster_portals[start_cluster]) {
+        uint32_t distance = this->get_cluster_distance(this->portals[portal].position);
+
+        if (distance != unreachable) {
+            this->costs[portal] = distance;
+            this->parents[portal] = unreachable;
+            this->heap.push(portal, static_cast<float>(distance) + this->estimate(portal, goal));
+        }
+    }
+
+    while (not this->heap.empty()) {
+        uint32_t portal = this->heap.pop();
+
+        if (portal == goal_node) {
+            break;
+        }
+
+        auto relax = [&](uint32_t node, uint32_t cost, float key) {
+            if (cost < this->costs[node]) {
+                this->costs[node] = cost;
+                this->parents[node] = portal;
+                this->heap.push(node, key);
+            }
+        };
+
+        for (const auto& link : this->links[portal]) {
+            uint32_t cost = this->costs[portal] + link.cost;
+            relax(link.portal, cost, static_cast<float>(cost) + this->estimate(link.portal, goal));
+        }
+
+        if (this->goal_distances[portal] != unreachable) {
+            uint32_t cost = this->costs[portal] + this->goal_distances[portal];
+            relax(goal_node, cost, static_cast<float>(cost));
+        }
+    }
+
+    for (uint32_t portal : this->cluster_portals[goal_cluster]) {
+        this->goal_distances[portal] = unreachable;
+    }
+
+    if (this->costs[goal_node] == unreachable) {
+        return unreachable;
+    }
+
+    std::vector<uint32_t> path;
+
+    for (uint32_t node = this->parents[goal_node]; node != unreachable; node = this->parents[node]) {
+        path.push_back(node);
+    }
+
+    this->route.push_back(start);
+
+    for (auto portal = path.rbegin(); portal != path.rend(); portal++) {
+        this->append_path(maze, this->route.back(), this->portals[*portal].position);
+    }
+
+    this->append_path(maze, this->route.back(), goal);
+
+    return this->costs[goal_node];
+}
+
+const std::vector<LargePoint>& HierarchicalPlanner::get_route() const {
+    return this->route;
+}
+
+uint32_t HierarchicalPlanner::get_portal_count() const {
+    return this->portals.size();
+}
+
+uint32_t HierarchicalPlanner::get_cluster(const LargePoint& position) const {
+    return position.y / this->cluster_size * this->cluster_columns + position.x / this->cluster_size;
+}
+
+void HierarchicalPlanner::add_portals(const LargeMaze& maze, const LargePoint& first, uint16_t length, Side side) {
+    Side       step = side == Side::RIGHT ? Side::UP : Side::RIGHT;
+    Side       back = side == Side::RIGHT ? Side::DOWN : Side::LEFT;
+    LargePoint position = first;
+    uint16_t   run_length = 0;
+
+    auto add_portal = [this](const LargePoint& position) {
+        this->portals.push_back({position, this->get_cluster(position)});
+        this->links.emplace_back();
+        this->cluster_portals[this->portals.back().cluster].push_back(this->portals.size() - 1);
+        return static_cast<uint32_t>(this->portals.size() - 1);
+    };
+
+    // A run is closed by a wall or by the end of the line, which the last iteration stands for
+    for (uint16_t i = 0; i <= length; i++, position = position + step) {
+        bool open = i < length and not maze.has_wall(position, side);
+
+        // Runs only grow along cells open to each other on both sides, so every cell reaches the portals of its run
+        // without leaving its cluster, and no route is lost to the abstraction
+        if (open and run_length > 0 and not maze.has_wall(position, back) and
+            not maze.has_wall(position + side, back)) {
+            run_length++;
+            continue;
+        }
+
+        if (run_length > 0) {
+            auto       offset = static_cast<uint16_t>(i - (run_length + 1) / 2);
+            LargePoint middle = step == Side::UP ? LargePoint{first.x, static_cast<uint16_t>(first.y + offset)} :
+                                                   LargePoint{static_cast<uint16_t>(first.x + offset), first.y};
+            uint32_t   portal = add_portal(middle);
+            uint32_t   front_portal = add_portal(middle + side);
+
+            this->links[portal].push_back({front_portal, 1});
+            this->links[front_portal].push_back({portal, 1});
+        }
+
+        run_length = open ? 1 : 0;
+    }
+}
+
+void HierarchicalPlanner::add_landmarks(const LargeMaze& maze) {
+    auto     portal_count = static_cast<uint32_t>(this->portals.size());
+    uint16_t last_x = maze.get_width() - 1;
+    uint16_t last_y = maze.get_height() - 1;
+
+    std::array<LargePoint, landmark_count> targets = {
+        LargePoint{0, 0},
+        {static_cast<uint16_t>(last_x / 2), 0},
+        {last_x, 0},
+        {last_x, static_cast<uint16_t>(last_y / 2)},
+        {last_x, last_y},
+        {static_cast<uint16_t>(last_x / 2), last_y},
+        {0, last_y},
+        {0, static_cast<uint16_t>(last_y / 2)},
+    };
+
+    this->landmark_distances.assign(portal_count * landmark_count, unreachable);
+
+    for (uint8_t landmark = 0; landmark < landmark_count and portal_count > 0; landmark++) {
+        const LargePoint& target = targets[landmark];
+        uint32_t          source = 0;
+
+        auto distance_to_target = [&target](const LargePoint& position) {
+            return std::abs(position.x - target.x) + std::abs(position.y - target.y);
+        };
+
+        // Landmarks far from each other on the border bound well the routes running between them
+        for (uint32_t portal = 1; portal < portal_count; portal++) {
+            if (distance_to_target(this->portals[portal].position) <
+                distance_to_target(this->portals[source].position)) {
+                source = portal;
+            }
+        }
+
+        std::fill(this->costs.begin(), this->costs.end(), unreachable);
+        this->costs[source] = 0;
+        this->heap.clear();
+        this->heap.push(source, 0.0F);
+
+        while (not this->heap.empty()) {
+            uint32_t portal = this->heap.pop();
+
+            for (const auto& link : this->links[portal]) {
+                if (this->costs[portal] + link.cost < this->costs[link.portal]) {
+                    this->costs[link.portal] = this->costs[portal] + link.cost;
+                    this->heap.push(link.portal, static_cast<float>(this->costs[link.portal]));
+                }
+            }
+        }
+
+        for (uint32_t portal = 0; portal < portal_count; portal++) {
+            this->landmark_distances[portal * landmark_count + landmark] = this->costs[portal];
+        }
+    }
+}
+
+float HierarchicalPlanner::estimate(uint32_t portal, const LargePoint& goal) const {
+    const LargePoint& position = this->portals[portal].position;
+    auto              bound = static_cast<uint32_t>(std::abs(position.x - goal.x) + std::abs(position.y - goal.y));
+
+    // The distances to a landmark of two nodes differ by at most the distance between them
+    for (uint8_t landmark = 0; landmark < landmark_count; landmark++) {
+        uint32_t distance = this->landmark_distances[portal * landmark_count + landmark];
+        uint32_t goal_distance = this->goal_landmark_distances[landmark];
+
+        if (distance != unreachable and goal_distance != unreachable) {
+            bound = std::max(bound, distance > goal_distance ? distance - goal_distance : goal_distance - distance);
+        }
+    }
+
+    return static_cast<float>(bound);
+}
+
+void HierarchicalPlanner::search_cluster(const LargeMaze& maze, const LargePoint& origin) {
+    this->cluster_origin = {
+        static_cast<uint16_t>(origin.x / this->cluster_size * this->cluster_size),
+        static_cast<uint16_t>(origin.y / this->cluster_size * this->cluster_size)
+    };
+    auto cluster_width = static_cast<uint16_t>(
+        std::min<int>(this->cluster_size, maze.get_width() - this->cluster_origin.x)
+    );
+    auto cluster_height = static_cast<uint16_t>(
+        std::min<int>(this->cluster_size, maze.get_height() - this->cluster_origin.y)
+    );
+
+    auto local_index = [this](const LargePoint& position) {
+        return static_cast<uint16_t>(
+            (position.y - this->cluster_origin.y) * this->cluster_size + position.x - this->cluster_origin.x
+        );
+    };
+
+    std::fill(this->cluster_distances.begin(), this->cluster_distances.end(), unreachable);
+    this->cluster_distances[local_index(origin)] = 0;
+    this->cluster_queue[0] = local_index(origin);
+
+    for (uint16_t head = 0, tail = 1; head < tail; head++) {
+        uint16_t   current = this->cluster_queue[head];
+        LargePoint position{
+            static_cast<uint16_t>(this->cluster_origin.x + current % this->cluster_size),
+            static_cast<uint16_t>(this->cluster_origin.y + current / this->cluster_size)
+        };
+
+        for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+            Side       side = static_cast<Side>(i);
+            LargePoint front = position + side;
+
+            // The offsets wrap around past the bottom and left borders, so one check covers the four borders
+            if (maze.has_wall(position, side) or
+                static_cast<uint16_t>(front.x - this->cluster_origin.x) >= cluster_width or
+                static_cast<uint16_t>(front.y - this->cluster_origin.y) >= cluster_height) {
+                continue;
+            }
+
+            uint16_t front_index = local_index(front);
+
+            if (this->cluster_distances[front_index] == unreachable) {
+                this->cluster_distances[front_index] = this->cluster_distances[current] + 1;
+                this->cluster_queue[tail++] = front_index;
+            }
+        }
+    }
+}
+
+uint32_t HierarchicalPlanner::get_cluster_distance(const LargePoint& position) const {
+    return this->cluster_distances
+        [(position.y - this->cluster_origin.y) * this->cluster_size + position.x - this->cluster_origin.x];
+}
+
+void HierarchicalPlanner::append_path(const LargeMaze& maze, const LargePoint& from, const LargePoint& to) {
+    if (from == to) {
+        return;
+    }
+
+    // Portals facing each other are one step apart, in different clusters
+    if (this->get_cluster(from) != this->get_cluster(to)) {
+        this->route.push_back(to);
+        return;
+    }
+
+    this->search_cluster(maze, to);
+
+    // Descending the distances to the target gives the cells in the order they are driven
+    for (LargePoint position = from; not(position == to);) {
+        for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+            auto       side = static_cast<Side>(i);
+            LargePoint front = position + side;
+
+            if (not maze.has_wall(position, side) and this->get_cluster(front) == this->get_cluster(to) and
+                this->get_cluster_distance(front) + 1 == this->get_cluster_distance(position)) {
+                position = front;
+                break;
+            }
+        }
+
+        this->route.push_back(position);
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef INDEXED_HEAP_CPP
+#define INDEXED_HEAP_CPP
+
+#include <utility>
+
+#include "indexed_heap.hpp"
+
+template <uint32_t capacity>
+IndexedHeap<capacity>::IndexedHeap(uint32_t item_count) {
+    fill_buffer(this->heap, item_count, Index{});
+    fill_buffer(this->positions, item_count, none);
+    fill_buffer(this->keys, item_count, 0.0F);
+}
+
+template <uint32_t capacity>
+void IndexedHeap<capacity>::clear() {
+    for (Index position = 0; position < this->size; position++) {
+        this->positions[this->heap[position]] = none;
+    }
+
+    this->size = 0;
+}
+
+template <uint32_t capacity>
+bool IndexedHeap<capacity>::empty() const {
+    return this->size == 0;
+}
+
+template <uint32_t capacity>
+void IndexedHeap<capacity>::push(Index item, float key) {
+    if (this->positions[item] == none) {
+        this->heap[this->size] = item;
+        this->positions[item] = this->size;
+        this->keys[item] = key;
+        this->sift_up(this->size++);
+        return;
+    }
+
+    if (key < this->keys[item]) {
+        this->keys[item] = key;
+        this->sift_up(this->positions[item]);
+    }
+}
+
+template <uint32_t capacity>
+IndexedHeap<capacity>::Index IndexedHeap<capacity>::pop() {
+    Index item = this->heap[0];
+
+    this->swap(0, --this->size);
+    this->positions[item] = none;
+    this->sift_down(0);
+
+    return item;
+}
+
+template <uint32_t capacity>
+void IndexedHeap<capacity>::sift_up(Index position) {
+    while (position > 0) {
+        Index parent = (position - 1) / 2;
+
+        if (this->keys[this->heap[parent]] <= this->keys[this->heap[position]]) {
+            return;
+        }
+
+        this->swap(parent, position);
+        position = parent;
+    }
+}
+
+template <uint32_t capacity>
+void IndexedHeap<capacity>::sift_down(Index position) {
+    while (true) {
+        uint32_t smallest = position;
+        uint32_t left = 2U * position + 1;
+        uint32_t right = left + 1;
+
+        if (left < this->size and this->keys[this->heap[left]] < this->keys[this->heap[smallest]]) {
+            smallest = left;
+        }
+
+        if (right < this->size and this->keys[this->heap[right]] < this->keys[this->heap[smallest]]) {
+            smallest = right;
+        }
+
+        if (smallest == position) {
+            return;
+        }
+
+        this->swap(position, smallest);
+        position = smallest;
+    }
+}
+
+template <uint32_t capacity>
+void IndexedHeap<capacity>::swap(Index first, Index second) {
+    std::swap(this->heap[first], this->heap[second]);
+    this->positions[this->heap[first]] = first;
+    this->positions[this->heap[second]] = second;
+}
+
+#endif  // INDEXED_HEAP_CPP
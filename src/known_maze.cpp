@@ -1,93 +1,473 @@
 #ifndef KNOWN_MAZE_CPP
 #define KNOWN_MAZE_CPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <format>
-#include <iterator>
-#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "known_maze.hpp"
+#include "profiler.hpp"
 
 template <uint8_t width, uint8_t height>
-KnownMaze<width, height>::KnownMaze(const GridPose& start) :
+KnownMaze<width, height>::KnownMaze(const GridPose& start, const GridSize<width, height>& size) :
+    GridSize<width, height>(size),
+    walls(size),
+    costmap(size),
+    start_costmap(size),
+    explored_costmap(size),
+    frontier_costmap(size),
+    explored_walls(size),
+    frontier(size),
+    visited(size),
     start(start),
-    goal(
-        {{width / 2, height / 2},
-         {(width - 1) / 2, height / 2},
-         {width / 2, (height - 1) / 2},
-         {(width - 1) / 2, (height - 1) / 2}}
-    ) {
-    for (uint8_t row = 0; row < height; row++) {
-        this->cells[row][0].wall_count[Side::LEFT] = 0xFFFF;
-        this->cells[row][width - 1].wall_count[Side::RIGHT] = 0xFFFF;
-    }
+    start_cell(size),
+    goal(size) {
+    fill_buffer(this->east_evidence, this->get_cell_count(), Evidence{});
+    fill_buffer(this->north_evidence, this->get_cell_count(), Evidence{});
+    fill_buffer(this->best_route, this->get_cell_count(), GridPoint{});
+    fill_buffer(this->best_route_step, this->get_cell_count(), uint16_t{0xFFFF});
+    this->set_sensor_model(SensorModel{});
+
+    // The central goal has one cell along the odd sides of the maze and two along the even ones
+    GridPoint goal_position{
+        static_cast<uint8_t>((this->get_width() - 1) / 2), static_cast<uint8_t>((this->get_height() - 1) / 2)
+    };
+    this->goal.set(goal_position);
+    this->goal.set({static_cast<uint8_t>(this->get_width() / 2), goal_position.y});
+    this->goal.set({goal_position.x, static_cast<uint8_t>(this->get_height() / 2)});
+    this->goal.set({static_cast<uint8_t>(this->get_width() / 2), static_cast<uint8_t>(this->get_height() / 2)});
+
+    this->reset(start);
+}
 
-    for (uint8_t col = 0; col < width; col++) {
-        this->cells[0][col].wall_count[Side::DOWN] = 0xFFFF;
-        this->cells[height - 1][col].wall_count[Side::UP] = 0xFFFF;
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::reset(const GridPose& start) {
+    this->start = start;
+    this->returning = false;
+    this->exploring = true;
+    this->route_proven = false;
+    this->walls.reset();
+    this->visited.clear();
+    this->frontier.clear();
+
+    std::fill(this->east_evidence.begin(), this->east_evidence.end(), Evidence{});
+    std::fill(this->north_evidence.begin(), this->north_evidence.end(), Evidence{});
+
+    this->start_cell.clear();
+    this->start_cell.set(start.position);
+
+    this->clear_best_route();
+    this->costmap.reset(this->walls, this->goal);
+    this->start_costmap.reset(this->walls, this->start_cell);
+
+    this->map_version++;
+    this->costmap_version = this->map_version;
+    this->start_costmap_version = this->map_version;
+    this->reset_explored_costmap();
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::load(const MazeRecord& record) {
+    static_assert(sizeof(Evidence) == 2, "The evidence is copied as two bytes per wall");
+
+    if (record.width != this->get_width() or record.height != this->get_height()) {
+        throw std::runtime_error(
+            std::string(record.source) + ": byte " + std::to_string(record.offset) + ": expected a " +
+            std::to_string(this->get_width()) + "x" + std::to_string(this->get_height()) + " maze, found " +
+            std::to_string(record.width) + "x" + std::to_string(record.height)
+        );
     }
 
-    for (const auto& position : this->goal) {
-        this->get_cell(position).cost = 0;
+    this->reset(record.get_start());
+    this->walls.load(record);
+
+    bool has_evidence = (record.header.flags & MazeRecordHeader::has_evidence) != 0;
+
+    if (has_evidence and record.header.version == MazeRecord::version) {
+        std::memcpy(this->east_evidence.data(), record.get_east_evidence().data(), record.get_east_evidence().size());
+        std::memcpy(
+            this->north_evidence.data(), record.get_north_evidence().data(), record.get_north_evidence().size()
+        );
+    } else {
+        // Counted readings are weighed as if read by the front sensor
+        auto to_evidence = [this](uint8_t wall_count, uint8_t free_count) {
+            int belief = wall_count * this->wall_weights[Sensor::FRONT_SENSOR] +
+                         free_count * this->free_weights[Sensor::FRONT_SENSOR];
+            return Evidence{
+                static_cast<int8_t>(std::clamp(belief, -belief_cap, belief_cap)),
+                static_cast<uint8_t>(std::min(wall_count + free_count, 0xFF))
+            };
+        };
+
+        for (uint8_t row = 0; row < this->get_height(); row++) {
+            for (uint8_t col = 0; col < this->get_width(); col++) {
+                std::size_t i = this->index({col, row});
+
+                if (has_evidence) {
+                    std::string_view east = record.get_east_evidence().substr(2 * i, 2);
+                    std::string_view north = record.get_north_evidence().substr(2 * i, 2);
+
+                    this->east_evidence[i] = to_evidence(static_cast<uint8_t>(east[0]), static_cast<uint8_t>(east[1]));
+                    this->north_evidence[i] = to_evidence(
+                        static_cast<uint8_t>(north[0]), static_cast<uint8_t>(north[1])
+                    );
+                    continue;
+                }
+
+                bool east_wall = this->walls.has_wall({{col, row}, Side::RIGHT});
+                bool north_wall = this->walls.has_wall({{col, row}, Side::UP});
+
+                this->east_evidence[i] = to_evidence(east_wall ? 1 : 0, east_wall ? 0 : 1);
+                this->north_evidence[i] = to_evidence(north_wall ? 1 : 0, north_wall ? 0 : 1);
+            }
+        }
     }
 
-    this->calculate_costmap();
+    const MazeRecordHeader& header = record.header;
+
+    this->start_costmap.reset(this->walls, this->start_cell);
+
+    this->map_version++;
+    this->start_costmap_version = this->map_version;
+    this->set_goal(header.goal_position, header.goal_width, header.goal_height);
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::save(std::ostream& os) const {
+    MazeRecordHeader header = MazeRecord::make_header(this->get_width(), this->get_height());
+
+    // The goal is stored as its bounding box
+    auto [goal_min, goal_max] = this->goal.get_bounds();
+
+    header.flags = MazeRecordHeader::has_evidence;
+    header.start_position = this->start.position;
+    header.start_orientation = this->start.orientation;
+    header.goal_position = goal_min;
+    header.goal_width = goal_max.x - goal_min.x + 1;
+    header.goal_height = goal_max.y - goal_min.y + 1;
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    this->walls.save(os);
+    os.write(
+        reinterpret_cast<const char*>(this->east_evidence.data()),
+        static_cast<std::streamsize>(2 * this->get_cell_count())
+    );
+    os.write(
+        reinterpret_cast<const char*>(this->north_evidence.data()),
+        static_cast<std::streamsize>(2 * this->get_cell_count())
+    );
 }
 
 template <uint8_t width, uint8_t height>
 void KnownMaze<width, height>::update(const GridPose& pose, Information information) {
-    if (this->goal.contains(pose.position)) {
+    PROFILE_SCOPE(MAZE_UPDATE_TIME);
+
+    if (this->goal.contains(pose.position) and this->strategy != ExplorationStrategy::FRONTIER) {
         this->returning = true;
-    } else if (pose == start.turned_back()) {
+    } else if (pose.position == this->start.position and this->exploring and
+               (this->route_proven or (this->returning and this->frontier.empty()))) {
+        // Without the proof, as for the goal strategy or once no cell is left to visit, the robot must be on its way
+        // back, as walls read by mistake can turn it back at the start. The start is the end of the route back,
+        // whichever side it is entered from, so the robot stops there instead of asking the route for its own cell.
         this->exploring = false;
         this->returning = false;
+
+        // Ties in the costmap can lead the route through walls never seen, so the fast run keeps to explored walls
+        if (this->explored_costmap.get_cost(this->start.position) != 0xFFFF) {
+            this->calculate_best_route(this->explored_costmap, this->explored_walls);
+        }
     }
 
     if (not this->exploring) {
         return;
     }
 
-    if (information.left != Information::UNKNOWN) {
-        this->update_wall(pose.turned_left(), information.left == Information::WALL);
+    this->read(pose, information);
+    this->calculate_costmap();
+
+    // Walls read by mistake can enclose the robot, which is then let to read them again. They can also split the goal
+    // and leave the robot in a part cut off from the start, which only the start costmap shows, up to date unless the
+    // goal strategy is still on its way to the goal.
+    bool start_costmap_updated = this->returning or this->strategy != ExplorationStrategy::GOAL;
+
+    if (this->costmap.get_cost(pose.position) == 0xFFFF) {
+        this->forget_enclosing_walls(this->costmap);
+        this->calculate_costmap();
+    } else if (start_costmap_updated and this->start_costmap.get_cost(pose.position) == 0xFFFF) {
+        this->forget_enclosing_walls(this->start_costmap);
+        this->calculate_costmap();
     }
 
-    if (information.front_left != Information::UNKNOWN) {
-        this->update_wall(pose.front().turned_left(), information.front_left == Information::WALL);
+    this->update_exploration();
+
+    // Once no unseen wall can shorten the route, going further is useless, even for the goal strategy
+    if (this->route_proven and not this->returning) {
+        this->returning = true;
+
+        // The goal strategy defers the start costmap until it returns, so it is brought up to date with the route
+        this->calculate_costmap();
     }
+}
 
-    if (information.front != Information::UNKNOWN) {
-        this->update_wall(pose, information.front == Information::WALL);
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::read(const GridPose& pose, const Information& information) {
+    if (not this->exploring) {
+        return;
     }
 
-    if (information.front_right != Information::UNKNOWN) {
-        this->update_wall(pose.front().turned_right(), information.front_right == Information::WALL);
+    auto sensor_walls = get_sensor_walls(pose);
+    auto readings = get_readings(information);
+
+    this->visited.set(pose.position);
+
+    for (uint8_t i = 0; i < SensorModel::sensor_count; i++) {
+        this->read_wall(sensor_walls[i], static_cast<Sensor>(i), readings[i]);
     }
+}
+
+template <uint8_t width, uint8_t height>
+bool KnownMaze<width, height>::changes_map(const GridPose& pose, const Information& information) const {
+    auto sensor_walls = get_sensor_walls(pose);
+    auto readings = get_readings(information);
 
-    if (information.right != Information::UNKNOWN) {
-        this->update_wall(pose.turned_right(), information.right == Information::WALL);
+    for (uint8_t i = 0; i < SensorModel::sensor_count; i++) {
+        if (readings[i] == Information::UNKNOWN or this->walls.is_border(sensor_walls[i])) {
+            continue;
+        }
+
+        GridPose        edge = WallMap<width, height>::normalized(sensor_walls[i]);
+        const auto&     evidence_plane = edge.orientation == Side::RIGHT ? this->east_evidence : this->north_evidence;
+        const Evidence& evidence = evidence_plane[this->index(edge.position)];
+        int             weight = readings[i] == Information::WALL ? this->wall_weights[i] : this->free_weights[i];
+        int             belief = std::clamp(evidence.belief + weight, -belief_cap, belief_cap);
+
+        if ((belief > 0) != (evidence.belief > 0) or (belief >= 0) != (evidence.belief >= 0)) {
+            return true;
+        }
     }
 
-    this->calculate_costmap();
+    return false;
 }
 
 template <uint8_t width, uint8_t height>
 GridPoint KnownMaze<width, height>::get_current_goal(const GridPoint& position, bool force_costmap) const {
-    uint16_t current_cost = this->get_cell(position).cost;
+    if (not force_costmap and this->exploring and not this->frontier.empty()) {
+        return this->descend(this->frontier_costmap, this->walls, position);
+    }
 
-    if (not force_costmap and (not this->exploring or this->returning) and this->best_route.contains(current_cost) and
-        this->best_route.at(current_cost) == position) {
-        return (this->returning ? std::prev(this->best_route.find(current_cost)) :
-                                  std::next(this->best_route.find(current_cost)))
-            ->second;
+    uint16_t route_step = this->best_route_step.at(this->index(position));
+
+    if (not force_costmap and (not this->exploring or this->returning) and route_step != 0xFFFF) {
+        if (this->returning) {
+            return this->best_route.at(route_step > 0 ? route_step - 1 : route_step);
+        }
+
+        if (route_step + 1 < this->best_route_length) {
+            return this->best_route.at(route_step + 1);
+        }
+    }
+
+    if (not force_costmap and this->returning) {
+        return this->descend(this->start_costmap, this->walls, position);
+    }
+
+    return this->descend(this->costmap, this->walls, position);
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::set_goal(const CellMask<width, height>& goal) {
+    if (goal.empty()) {
+        throw std::runtime_error("The goal must have at least one cell");
     }
 
+    this->goal = goal;
+    this->clear_best_route();
+    this->costmap.reset(this->walls, this->goal);
+    this->costmap_version = this->map_version;
+    this->reset_explored_costmap();
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::set_goal(const GridPoint& position, uint8_t goal_width, uint8_t goal_height) {
+    if (goal_width == 0 or goal_height == 0 or position.x + goal_width > this->get_width() or
+        position.y + goal_height > this->get_height()) {
+        throw std::runtime_error(
+            "The " + std::to_string(goal_width) + "x" + std::to_string(goal_height) + " goal at (" +
+            std::to_string(position.x) + ", " + std::to_string(position.y) + ") does not fit in the " +
+            std::to_string(this->get_width()) + "x" + std::to_string(this->get_height()) + " maze"
+        );
+    }
+
+    CellMask<width, height> goal(*this);
+
+    for (uint8_t row = position.y; row < position.y + goal_height; row++) {
+        for (uint8_t col = position.x; col < position.x + goal_width; col++) {
+            goal.set({col, row});
+        }
+    }
+
+    this->set_goal(goal);
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::set_incremental_costmap(bool incremental) {
+    this->incremental_costmap = incremental;
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::set_sensor_model(const SensorModel& model) {
+    for (uint8_t i = 0; i < SensorModel::sensor_count; i++) {
+        SensorNoise noise = model.get_noise(static_cast<Sensor>(i));
+
+        this->wall_weights[i] = get_reading_weight(1.0F - noise.false_negative, noise.false_positive);
+        this->free_weights[i] = static_cast<int8_t>(
+            -get_reading_weight(1.0F - noise.false_positive, noise.false_negative)
+        );
+    }
+}
+
+template <uint8_t width, uint8_t height>
+int8_t KnownMaze<width, height>::get_reading_weight(float likelihood, float false_likelihood) {
+    // A sensor that is never wrong settles the wall with a single reading
+    if (false_likelihood <= 0.0F) {
+        return belief_cap;
+    }
+
+    float weight = std::round(belief_scale * std::log(likelihood / false_likelihood));
+
+    return static_cast<int8_t>(std::clamp(weight, 0.0F, static_cast<float>(belief_cap)));
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::add_reading(Evidence& evidence, int8_t weight) {
+    // Capping the belief keeps it in a byte and lets a few readings correct a wall read wrong many times
+    evidence.belief = static_cast<int8_t>(std::clamp(evidence.belief + weight, -belief_cap, belief_cap));
+    evidence.reading_count += evidence.reading_count < 0xFF ? 1 : 0;
+}
+
+template <uint8_t width, uint8_t height>
+std::array<GridPose, SensorModel::sensor_count> KnownMaze<width, height>::get_sensor_walls(const GridPose& pose) {
+    return {
+        pose.turned_left(), pose.front().turned_left(), pose, pose.front().turned_right(), pose.turned_right()
+    };
+}
+
+template <uint8_t width, uint8_t height>
+std::array<Information::Existence, SensorModel::sensor_count> KnownMaze<width, height>::get_readings(
+    const Information& information
+) {
+    return {information.left, information.front_left, information.front, information.front_right, information.right};
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::set_exploration_strategy(ExplorationStrategy strategy) {
+    this->strategy = strategy;
+}
+
+template <uint8_t width, uint8_t height>
+ExplorationStrategy KnownMaze<width, height>::get_exploration_strategy() const {
+    return this->strategy;
+}
+
+template <uint8_t width, uint8_t height>
+bool KnownMaze<width, height>::is_route_proven() const {
+    return this->route_proven;
+}
+
+template <uint8_t width, uint8_t height>
+uint16_t KnownMaze<width, height>::get_route_gap() const {
+    uint16_t lower_bound = this->costmap.get_distance(this->start.position);
+    uint16_t upper_bound = this->explored_costmap.get_distance(this->start.position);
+
+    return upper_bound == 0xFFFF or lower_bound == 0xFFFF ? 0xFFFF : upper_bound - lower_bound;
+}
+
+template <uint8_t width, uint8_t height>
+bool KnownMaze<width, height>::is_exploring() const {
+    return this->exploring;
+}
+
+template <uint8_t width, uint8_t height>
+bool KnownMaze<width, height>::is_returning() const {
+    return this->returning;
+}
+
+template <uint8_t width, uint8_t height>
+bool KnownMaze<width, height>::is_visited(const GridPoint& position) const {
+    return this->visited.contains(position);
+}
+
+template <uint8_t width, uint8_t height>
+const CellMask<width, height>& KnownMaze<width, height>::get_goal() const {
+    return this->goal;
+}
+
+template <uint8_t width, uint8_t height>
+const GridPose& KnownMaze<width, height>::get_start() const {
+    return this->start;
+}
+
+template <uint8_t width, uint8_t height>
+const WallMap<width, height>& KnownMaze<width, height>::get_walls() const {
+    return this->walls;
+}
+
+template <uint8_t width, uint8_t height>
+const WallMap<width, height>& KnownMaze<width, height>::get_explored_walls() const {
+    return this->explored_walls;
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::fill_explored_walls(WallMap<width, height>& explored_walls) const {
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        for (uint8_t col = 0; col < this->get_width(); col++) {
+            const Evidence& east = this->east_evidence[this->index({col, row})];
+            const Evidence& north = this->north_evidence[this->index({col, row})];
+
+            explored_walls.set_wall({{col, row}, Side::RIGHT}, east.belief >= 0);
+            explored_walls.set_wall({{col, row}, Side::UP}, north.belief >= 0);
+        }
+    }
+}
+
+template <uint8_t width, uint8_t height>
+uint16_t KnownMaze<width, height>::get_cost(const GridPoint& position) const {
+    return this->costmap.get_cost(position);
+}
+
+template <uint8_t width, uint8_t height>
+const Costmap<width, height>& KnownMaze<width, height>::get_costmap() const {
+    return this->costmap;
+}
+
+template <uint8_t width, uint8_t height>
+const Costmap<width, height>& KnownMaze<width, height>::get_start_costmap() const {
+    return this->start_costmap;
+}
+
+template <uint8_t width, uint8_t height>
+const Costmap<width, height>& KnownMaze<width, height>::get_explored_costmap() const {
+    return this->explored_costmap;
+}
+
+template <uint8_t width, uint8_t height>
+GridPoint KnownMaze<width, height>::descend(
+    const Costmap<width, height>& costmap, const WallMap<width, height>& walls, const GridPoint& position
+) const {
+    uint16_t  current_cost = costmap.get_cost(position);
     GridPoint next_position = position;
 
     for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
         Side      side = static_cast<Side>(i);
         GridPoint front_position = position + side;
 
-        if (not this->has_wall({position, side}) and this->get_cell(front_position).cost <= current_cost) {
-            current_cost = this->get_cell(front_position).cost;
+        if (not walls.has_wall({position, side}) and costmap.get_cost(front_position) <= current_cost) {
+            current_cost = costmap.get_cost(front_position);
             next_position = front_position;
         }
     }
@@ -96,98 +476,247 @@ GridPoint KnownMaze<width, height>::get_current_goal(const GridPoint& position,
 }
 
 template <uint8_t width, uint8_t height>
-const KnownMaze<width, height>::Cell& KnownMaze<width, height>::get_cell(const GridPoint& position) const {
-    return this->cells.at(position.y).at(position.x);
+void KnownMaze<width, height>::read_wall(const GridPose& pose, Sensor sensor, Information::Existence reading) {
+    if (reading == Information::WALL) {
+        this->update_wall(pose, this->wall_weights[sensor]);
+    } else if (reading == Information::FREE) {
+        this->update_wall(pose, this->free_weights[sensor]);
+    }
 }
 
 template <uint8_t width, uint8_t height>
-KnownMaze<width, height>::Cell& KnownMaze<width, height>::get_cell(const GridPoint& position) {
-    return this->cells.at(position.y).at(position.x);
-}
+void KnownMaze<width, height>::update_wall(const GridPose& pose, int8_t weight) {
+    PROFILE_SCOPE(WALL_UPDATE_TIME);
 
-template <uint8_t width, uint8_t height>
-void KnownMaze<width, height>::update_wall(const GridPose& pose, bool wall) {
-    if (wall) {
-        this->get_cell(pose.position).wall_count[pose.orientation]++;
-    } else {
-        this->get_cell(pose.position).free_count[pose.orientation]++;
+    if (this->walls.is_border(pose)) {
+        return;
     }
 
-    GridPose front_pose = pose.front();
+    GridPose  edge = WallMap<width, height>::normalized(pose);
+    auto&     evidence_plane = edge.orientation == Side::RIGHT ? this->east_evidence : this->north_evidence;
+    Evidence& evidence = evidence_plane[this->index(edge.position)];
 
-    if (front_pose.position.x >= width or front_pose.position.y >= height) {
-        return;
+    bool explored_wall = evidence.belief >= 0;
+    add_reading(evidence, weight);
+
+    bool has_wall = evidence.belief > 0;
+
+    // The explored walls bound the length of the route from above as the walls bound it from below, so both are kept
+    if (explored_wall != (evidence.belief >= 0)) {
+        this->explored_walls.set_wall(edge, not explored_wall);
+        this->explored_costmap.invalidate(edge);
+        this->explored_version++;
     }
 
-    if (wall) {
-        this->get_cell(front_pose.position).wall_count[pose.turned_back().orientation]++;
-    } else {
-        this->get_cell(front_pose.position).free_count[pose.turned_back().orientation]++;
+    if (has_wall != this->walls.has_wall(edge)) {
+        PROFILE_SAMPLE(WALL_FLIPS, 1);
+        this->walls.set_wall(edge, has_wall);
+        this->costmap.invalidate(edge);
+        this->start_costmap.invalidate(edge);
+        this->map_version++;
+    }
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::forget_enclosing_walls(const Costmap<width, height>& costmap) {
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        for (uint8_t col = 0; col < this->get_width(); col++) {
+            for (Side side : {Side::RIGHT, Side::UP}) {
+                GridPose edge{{col, row}, side};
+
+                if (this->walls.is_border(edge) or not this->walls.has_wall(edge)) {
+                    continue;
+                }
+
+                bool reachable = costmap.get_cost(edge.position) != 0xFFFF;
+                bool front_reachable = costmap.get_cost(edge.front().position) != 0xFFFF;
+
+                if (reachable == front_reachable) {
+                    continue;
+                }
+
+                auto& evidence_plane = side == Side::RIGHT ? this->east_evidence : this->north_evidence;
+                evidence_plane[this->index(edge.position)].belief = 0;
+
+                this->walls.set_wall(edge, false);
+                this->costmap.invalidate(edge);
+                this->start_costmap.invalidate(edge);
+                this->map_version++;
+            }
+        }
     }
 }
 
 template <uint8_t width, uint8_t height>
 bool KnownMaze<width, height>::has_wall(const GridPose& pose) const {
-    return this->get_cell(pose.position).wall_count[pose.orientation] >
-           this->get_cell(pose.position).free_count[pose.orientation];
+    return this->walls.has_wall(pose);
 }
 
 template <uint8_t width, uint8_t height>
 void KnownMaze<width, height>::calculate_costmap() {
-    std::array<std::array<bool, width>, height> visited{};
-    std::array<std::array<Side, width>, height> origin{};
-    std::queue<GridPoint>                       queue;
+    PROFILE_SCOPE(COSTMAP_TIME);
+
+    // Most readings only confirm what is already known, leaving nothing to recompute
+    if (this->costmap_version != this->map_version) {
+        if (this->incremental_costmap) {
+            this->costmap.repair(this->walls);
+        } else {
+            this->costmap.reset(this->walls, this->goal);
+        }
 
-    for (const auto& position : this->goal) {
-        queue.push(position);
-        visited.at(position.y).at(position.x) = true;
+        this->costmap_version = this->map_version;
     }
 
-    while (not queue.empty()) {
-        GridPoint current_position = queue.front();
-        queue.pop();
+    if (not this->returning and this->strategy == ExplorationStrategy::GOAL) {
+        return;
+    }
 
-        const Cell& current_cell = this->get_cell(current_position);
+    // The start costmap is only needed on the way back or to find the shortest routes, so its repairs are deferred
+    if (this->start_costmap_version != this->map_version) {
+        if (this->incremental_costmap) {
+            this->start_costmap.repair(this->walls);
+        } else {
+            this->start_costmap.reset(this->walls, this->start_cell);
+        }
 
-        for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
-            Side      side = static_cast<Side>(i);
-            GridPoint front_position = current_position + side;
+        this->start_costmap_version = this->map_version;
+    }
+
+    if (not this->returning) {
+        return;
+    }
 
-            if (not this->has_wall({current_position, side}) and
-                not visited.at(front_position.y).at(front_position.x)) {
-                visited.at(front_position.y).at(front_position.x) = true;
-                origin.at(front_position.y).at(front_position.x) = side;
+    if (this->best_route_length == 0 or this->best_route_version != this->map_version) {
+        this->calculate_best_route(this->costmap, this->walls);
+    } else {
+        PROFILE_SAMPLE(SKIPPED_ROUTES, 1);
+    }
+}
 
-                this->get_cell(front_position).cost =
-                    (current_cell.cost + (this->goal.contains(current_position) or
-                                                  (side == origin.at(current_position.y).at(current_position.x)) ?
-                                              1 :
-                                              2));
-                queue.push(front_position);
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::update_exploration() {
+    PROFILE_SCOPE(EXPLORATION_TIME);
+
+    if (this->explored_costmap_version != this->explored_version) {
+        if (this->incremental_costmap) {
+            this->explored_costmap.repair(this->explored_walls);
+        } else {
+            this->explored_costmap.reset(this->explored_walls, this->goal);
+        }
+
+        this->explored_costmap_version = this->explored_version;
+    } else {
+        PROFILE_SAMPLE(SKIPPED_PROOFS, 1);
+    }
+
+    // Unseen walls are open in the costmap, so no route can be shorter than it and an explored route as short is proven
+    uint16_t route_distance = this->costmap.get_distance(this->start.position);
+    this->route_proven = this->explored_costmap.get_distance(this->start.position) == route_distance;
+
+    this->frontier.clear();
+
+    if (this->route_proven or this->strategy == ExplorationStrategy::GOAL or
+        (this->strategy == ExplorationStrategy::PROVE_OPTIMAL and not this->returning)) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        for (uint8_t col = 0; col < this->get_width(); col++) {
+            GridPoint position{col, row};
+            uint32_t  distance = this->costmap.get_distance(position) + this->start_costmap.get_distance(position);
+
+            if (distance != route_distance) {
+                continue;
+            }
+
+            if (not this->visited.contains(position)) {
+                this->frontier.set(position);
+            }
+
+            // Noise can leave a wall between visited cells with no belief either way, which only a new reading settles
+            for (Side side : {Side::RIGHT, Side::UP}) {
+                GridPose edge{position, side};
+
+                if (this->walls.is_border(edge) or this->walls.has_wall(edge) or
+                    not this->explored_walls.has_wall(edge)) {
+                    continue;
+                }
+
+                GridPoint front_position = position + side;
+                uint32_t  forward = this->start_costmap.get_distance(position) + 1 +
+                                   this->costmap.get_distance(front_position);
+                uint32_t  backward = this->start_costmap.get_distance(front_position) + 1 +
+                                    this->costmap.get_distance(position);
+
+                if (forward == route_distance or backward == route_distance) {
+                    this->frontier.set(position);
+                    this->frontier.set(front_position);
+                }
             }
         }
     }
 
-    if (not this->returning) {
+    // With no cell left to visit, the route cannot be proven and the robot returns as the goal strategy does
+    if (this->frontier.empty()) {
+        this->returning = true;
         return;
     }
 
+    this->frontier_costmap.reset(this->walls, this->frontier);
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::reset_explored_costmap() {
+    this->fill_explored_walls(this->explored_walls);
+    this->explored_costmap.reset(this->explored_walls, this->goal);
+    this->explored_costmap_version = this->explored_version;
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::calculate_best_route(
+    const Costmap<width, height>& costmap, const WallMap<width, height>& walls
+) {
+    PROFILE_SCOPE(BEST_ROUTE_TIME);
+
+    this->best_route_version = this->map_version;
+    this->clear_best_route();
+
     GridPoint current_position = this->start.position;
-    this->best_route.clear();
-    this->best_route.try_emplace(this->get_cell(this->start.position).cost, this->start.position);
 
-    while (not this->goal.contains(current_position)) {
-        current_position = this->get_current_goal(current_position, true);
-        this->best_route.try_emplace(this->get_cell(current_position).cost, current_position);
+    while (true) {
+        this->best_route_step[this->index(current_position)] = this->best_route_length;
+        this->best_route[this->best_route_length++] = current_position;
+
+        if (this->goal.contains(current_position) or this->best_route_length == this->get_cell_count()) {
+            break;
+        }
+
+        current_position = this->descend(costmap, walls, current_position);
     }
+
+    PROFILE_SAMPLE(BEST_ROUTE_LENGTH, this->best_route_length);
+}
+
+template <uint8_t width, uint8_t height>
+void KnownMaze<width, height>::clear_best_route() {
+    for (uint16_t step = 0; step < this->best_route_length; step++) {
+        this->best_route_step[this->index(this->best_route[step])] = 0xFFFF;
+    }
+
+    this->best_route_length = 0;
 }
 
 template <std::uint8_t width, std::uint8_t height>
 std::ostream& operator<<(std::ostream& os, const KnownMaze<width, height>& maze) {
-    std::array<std::array<std::string, (width * 2) + 1>, (height * 2) + 1> drawing_array;
+    std::uint8_t maze_width = maze.get_width();
+    std::uint8_t maze_height = maze.get_height();
+
+    std::vector<std::vector<std::string>> drawing_array(
+        (maze_height * 2) + 1, std::vector<std::string>((maze_width * 2) + 1)
+    );
 
-    for (std::uint8_t row = 0; row < height; row++) {
-        for (std::uint8_t col = 0; col < width; col++) {
+    for (std::uint8_t row = 0; row < maze_height; row++) {
+        for (std::uint8_t col = 0; col < maze_width; col++) {
             drawing_array[2 * row + 2][2 * col + 1] = maze.has_wall({{col, row}, Side::UP}) ? "%%" : "  ";
             drawing_array[2 * row + 1][2 * col + 2] = maze.has_wall({{col, row}, Side::RIGHT}) ? "%%" : "  ";
             drawing_array[2 * row][2 * col + 1] = maze.has_wall({{col, row}, Side::DOWN}) ? "%%" : "  ";
@@ -195,8 +724,8 @@ std::ostream& operator<<(std::ostream& os, const KnownMaze<width, height>& maze)
         }
     }
 
-    for (std::int8_t row = height * 2; row >= 0; row--) {
-        for (std::uint8_t col = 0; col <= width * 2; col++) {
+    for (std::int16_t row = maze_height * 2; row >= 0; row--) {
+        for (std::uint16_t col = 0; col <= maze_width * 2; col++) {
             if ((row % 2 == 0) and (col % 2 == 0)) {
                 drawing_array[row][col] = "%%";
             } else if ((row % 2 == 1) and (col % 2 == 1)) {
@@ -205,7 +734,9 @@ std::ostream& operator<<(std::ostream& os, const KnownMaze<width, height>& maze)
                 } else if (maze.goal.contains({static_cast<uint8_t>(col / 2), static_cast<uint8_t>(row / 2)})) {
                     drawing_array[row][col] = "[]";
                 } else {
-                    drawing_array[row][col] = std::format("{:02}", maze.cells[row / 2][col / 2].cost);
+                    drawing_array[row][col] = std::format(
+                        "{:02}", maze.costmap.get_cost({static_cast<uint8_t>(col / 2), static_cast<uint8_t>(row / 2)})
+                    );
                 }
             }
 
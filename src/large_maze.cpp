@@ -0,0 +1,64 @@
+#include "large_maze.hpp"
+
+LargeMaze::LargeMaze(uint16_t width, uint16_t height, bool walls) :
+    width(width),
+    height(height),
+    row_words((width + 63) / 64),
+    east_walls(static_cast<std::size_t>(this->row_words) * height, walls ? ~uint64_t{0} : 0),
+    north_walls(static_cast<std::size_t>(this->row_words) * height, walls ? ~uint64_t{0} : 0) { }
+
+uint16_t LargeMaze::get_width() const {
+    return this->width;
+}
+
+uint16_t LargeMaze::get_height() const {
+    return this->height;
+}
+
+uint32_t LargeMaze::get_cell_count() const {
+    return static_cast<uint32_t>(this->width) * this->height;
+}
+
+uint32_t LargeMaze::index(const LargePoint& position) const {
+    return static_cast<uint32_t>(position.y) * this->width + position.x;
+}
+
+bool LargeMaze::is_inside(const LargePoint& position) const {
+    return position.x < this->width and position.y < this->height;
+}
+
+bool LargeMaze::has_wall(const LargePoint& position, Side side) const {
+    if (not this->is_inside(position) or not this->is_inside(position + side)) {
+        return true;
+    }
+
+    const auto& plane = side == Side::RIGHT or side == Side::LEFT ? this->east_walls : this->north_walls;
+    uint32_t    bit = this->get_bit(position, side);
+
+    return ((plane[bit / 64] >> (bit % 64)) & 1U) != 0;
+}
+
+void LargeMaze::set_wall(const LargePoint& position, Side side, bool wall) {
+    if (not this->is_inside(position) or not this->is_inside(position + side)) {
+        return;
+    }
+
+    auto&    plane = side == Side::RIGHT or side == Side::LEFT ? this->east_walls : this->north_walls;
+    uint32_t bit = this->get_bit(position, side);
+    uint64_t mask = uint64_t{1} << (bit % 64);
+
+    plane[bit / 64] = wall ? plane[bit / 64] | mask : plane[bit / 64] & ~mask;
+}
+
+uint32_t LargeMaze::get_bit(const LargePoint& position, Side side) const {
+    // The walls on the left and lower sides are stored as the right and upper walls of the neighbors
+    LargePoint edge = position;
+
+    if (side == Side::LEFT) {
+        edge.x--;
+    } else if (side == Side::DOWN) {
+        edge.y--;
+    }
+
+    return static_cast<uint32_t>(edge.y) * this->row_words * 64 + edge.x;
+}
@@ -2,19 +2,24 @@
 
 #include "maze.hpp"
 #include "micras.hpp"
+#include "renderer.hpp"
 
 int main() {
     Maze<5, 5>   maze("/home/gabriel-cosme/Codes/Micras/MazeSolver/mazes/test2.txt");
     Micras<5, 5> micras{{0, 0, Side::UP}};
 
+    Renderer<5, 5> renderer;
+
+    // The renderer keeps its buffers across the frames, so the robot is drawn through it from the first one
     std::cout << maze << '\n';
-    std::cout << micras << '\n';
+    renderer.write(std::cout, micras.get_known_maze(), micras.get_pose());
+    std::cout << '\n';
 
     while (true) {
         while (std::cin.get() != '\n') { }
 
         micras.step(maze.get_information(micras.get_pose()));
-        std::cout << micras << '\n';
+        renderer.draw(std::cout, micras.get_known_maze(), micras.get_pose());
     }
 
     return 0;
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <fcntl.h>
+#include <filesystem>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.hpp"
+
+MappedFile::MappedFile(const std::string& filename) {
+    int file = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (file < 0) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+
+    struct stat status {};
+
+    if (fstat(file, &status) != 0) {
+        close(file);
+        throw std::runtime_error("Could not read the size of file " + filename);
+    }
+
+    this->size = static_cast<std::size_t>(status.st_size);
+
+    // Empty files can not be mapped, they are kept as an empty view
+    if (this->size > 0) {
+        this->address = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (this->address == MAP_FAILED) {
+            this->address = nullptr;
+            close(file);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+
+        madvise(this->address, this->size, MADV_SEQUENTIAL);
+    }
+
+    close(file);
+}
+
+MappedFile::~MappedFile() {
+    if (this->address != nullptr) {
+        munmap(this->address, this->size);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : address(other.address), size(other.size) {
+    other.address = nullptr;
+    other.size = 0;
+}
+
+std::string_view MappedFile::get_data() const {
+    return {static_cast<const char*>(this->address), this->size};
+}
+
+std::vector<std::string> MappedFile::list_files(const std::string& path) {
+    if (not std::filesystem::is_directory(path)) {
+        return {path};
+    }
+
+    std::vector<std::string> filenames;
+
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        if (entry.is_regular_file()) {
+            filenames.push_back(entry.path().string());
+        }
+    }
+
+    std::sort(filenames.begin(), filenames.end());
+
+    return filenames;
+}
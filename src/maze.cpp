@@ -1,65 +1,125 @@
 #ifndef MAZE_CPP
 #define MAZE_CPP
 
-#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "maze.hpp"
 
 template <std::uint8_t width, std::uint8_t height>
 Maze<width, height>::Maze(const std::string& filename) {
-    std::ifstream file(filename);
-    std::string   buffer(4, ' ');
+    MazeReader reader(filename);
+    MazeText   text{};
 
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file " + filename);
+    if (not reader.next(text)) {
+        throw std::runtime_error("No maze in file " + filename);
     }
 
-    for (std::uint8_t col = 0; col < width; col++) {
-        file.read(buffer.data(), 4);
-        this->walls[height - 1][col][Side::UP] = (buffer[2] == '%');
+    this->load(text);
+}
+
+template <std::uint8_t width, std::uint8_t height>
+Maze<width, height>::Maze(const MazeText& text) {
+    this->load(text);
+}
+
+template <std::uint8_t width, std::uint8_t height>
+Maze<width, height>::Maze(const MazeRecord& record) {
+    this->resize(
+        record.width, record.height, std::string(record.source) + ": byte " + std::to_string(record.offset) + ":"
+    );
+    this->walls.load(record);
+    this->build_sensor_table();
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Maze<width, height>::resize(std::uint8_t maze_width, std::uint8_t maze_height, const std::string& location) {
+    if constexpr (GridSize<width, height>::dynamic) {
+        static_cast<GridSize<width, height>&>(*this) = {maze_width, maze_height};
+        this->walls = WallMap<width, height>(*this);
+    } else if (maze_width != width or maze_height != height) {
+        throw std::runtime_error(
+            location + " expected a " + std::to_string(width) + "x" + std::to_string(height) + " maze, found " +
+            std::to_string(maze_width) + "x" + std::to_string(maze_height)
+        );
     }
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Maze<width, height>::load(const MazeText& text) {
+    this->resize(text.width, text.height, std::string(text.source) + ":" + std::to_string(text.line) + ":1:");
 
-    file.ignore(1000, '\n');
+    // The drawing starts at the top row, each cell being 4 characters wide after the 2 of the left border
+    for (std::uint8_t row = 0; row < this->get_height(); row++) {
+        std::uint8_t     y = this->get_height() - 1 - row;
+        std::string_view cells = text.get_row(2 * row + 1);
+        std::string_view floor = text.get_row(2 * row + 2);
 
-    for (std::int8_t row = height - 1; row >= 0; row--) {
-        file.ignore(1);
+        for (std::uint8_t col = 0; col + 1 < this->get_width(); col++) {
+            this->walls.set_wall({{col, y}, Side::RIGHT}, cells[4 * col + 5] == '%');
+        }
 
-        for (std::uint8_t col = 0; col < width; col++) {
-            file.read(buffer.data(), 4);
-            this->walls[row][col][Side::LEFT] = (buffer[0] == '%');
-            this->walls[row][col][Side::RIGHT] = (buffer[3] == '%');
+        if (y == 0) {
+            continue;
         }
 
-        file.ignore(1000, '\n');
+        for (std::uint8_t col = 0; col < this->get_width(); col++) {
+            this->walls.set_wall({{col, static_cast<std::uint8_t>(y - 1)}, Side::UP}, floor[4 * col + 3] == '%');
+        }
+    }
 
-        for (std::uint8_t col = 0; col < width; col++) {
-            file.read(buffer.data(), 4);
-            this->walls[row][col][Side::DOWN] = (buffer[2] == '%');
+    this->build_sensor_table();
+}
 
-            if (row > 0) {
-                this->walls[row - 1][col][Side::UP] = (buffer[2] == '%');
+template <std::uint8_t width, std::uint8_t height>
+void Maze<width, height>::build_sensor_table() {
+    auto reading = [this](const GridPose& pose) {
+        return this->walls.has_wall(pose) ? Information::WALL : Information::FREE;
+    };
+
+    fill_buffer(this->sensor_table, 4 * this->get_cell_count(), Information{});
+
+    for (std::uint8_t row = 0; row < this->get_height(); row++) {
+        for (std::uint8_t col = 0; col < this->get_width(); col++) {
+            for (std::uint8_t side = Side::RIGHT; side <= Side::DOWN; side++) {
+                GridPose     pose{{col, row}, static_cast<Side>(side)};
+                Information& information = this->sensor_table[4 * this->index(pose.position) + side];
+
+                information.left = reading(pose.turned_left());
+                information.front = reading(pose);
+                information.right = reading(pose.turned_right());
+
+                // A wall in front hides the walls of the next cell from the diagonal sensors
+                if (information.front == Information::FREE) {
+                    information.front_left = reading(pose.front().turned_left());
+                    information.front_right = reading(pose.front().turned_right());
+                }
             }
         }
-
-        file.ignore(1000, '\n');
     }
 }
 
 template <std::uint8_t width, std::uint8_t height>
 std::ostream& operator<<(std::ostream& os, const Maze<width, height>& maze) {
-    std::array<std::array<std::string, (width * 2) + 1>, (height * 2) + 1> drawing_array;
-
-    for (std::uint8_t row = 0; row < height; row++) {
-        for (std::uint8_t col = 0; col < width; col++) {
-            drawing_array[2 * row][2 * col + 1] = maze.walls[row][col][Side::UP] ? "██" : "  ";
-            drawing_array[2 * row + 1][2 * col + 2] = maze.walls[row][col][Side::RIGHT] ? "██" : "  ";
-            drawing_array[2 * row + 2][2 * col + 1] = maze.walls[row][col][Side::DOWN] ? "██" : "  ";
-            drawing_array[2 * row + 1][2 * col] = maze.walls[row][col][Side::LEFT] ? "██" : "  ";
+    std::uint8_t maze_width = maze.get_width();
+    std::uint8_t maze_height = maze.get_height();
+
+    std::vector<std::vector<std::string>> drawing_array(
+        (maze_height * 2) + 1, std::vector<std::string>((maze_width * 2) + 1)
+    );
+
+    for (std::uint8_t row = 0; row < maze_height; row++) {
+        for (std::uint8_t col = 0; col < maze_width; col++) {
+            drawing_array[2 * row][2 * col + 1] = maze.walls.has_wall({{col, row}, Side::UP}) ? "██" : "  ";
+            drawing_array[2 * row + 1][2 * col + 2] = maze.walls.has_wall({{col, row}, Side::RIGHT}) ? "██" : "  ";
+            drawing_array[2 * row + 2][2 * col + 1] = maze.walls.has_wall({{col, row}, Side::DOWN}) ? "██" : "  ";
+            drawing_array[2 * row + 1][2 * col] = maze.walls.has_wall({{col, row}, Side::LEFT}) ? "██" : "  ";
         }
     }
 
-    for (std::uint8_t row = 0; row <= height * 2; row++) {
-        for (std::uint8_t col = 0; col <= width * 2; col++) {
+    for (std::uint16_t row = 0; row <= maze_height * 2; row++) {
+        for (std::uint16_t col = 0; col <= maze_width * 2; col++) {
             if ((row % 2 == 0) and (col % 2 == 0)) {
                 drawing_array[row][col] = "██";
             } else if ((row % 2 == 1) and (col % 2 == 1)) {
@@ -77,58 +137,43 @@ std::ostream& operator<<(std::ostream& os, const Maze<width, height>& maze) {
 
 template <std::uint8_t width, std::uint8_t height>
 Information Maze<width, height>::get_information(const GridPose& pose) const {
-    Information information{};
+    return this->sensor_table[4 * this->index(pose.position) + pose.orientation];
+}
 
-    if (this->walls.at(pose.position.y).at(pose.position.x)[pose.orientation]) {
-        information.front = Information::WALL;
-        return information;
-    }
+template <std::uint8_t width, std::uint8_t height>
+void Maze<width, height>::save(std::ostream& os) const {
+    MazeRecordHeader header = MazeRecord::make_header(this->get_width(), this->get_height());
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    this->walls.save(os);
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Maze<width, height>::save_text(std::ostream& os) const {
+    std::string line;
 
-    information.front = Information::FREE;
-
-    switch (pose.orientation) {
-        case Side::RIGHT:
-            information.front_left = this->walls.at(pose.position.y).at(pose.position.x + 1)[Side::UP] ?
-                                         Information::WALL :
-                                         Information::FREE;
-
-            information.front_right = this->walls.at(pose.position.y).at(pose.position.x + 1)[Side::DOWN] ?
-                                          Information::WALL :
-                                          Information::FREE;
-            return information;
-
-        case Side::UP:
-            information.front_left = this->walls.at(pose.position.y + 1).at(pose.position.x)[Side::LEFT] ?
-                                         Information::WALL :
-                                         Information::FREE;
-
-            information.front_right = this->walls.at(pose.position.y + 1).at(pose.position.x)[Side::RIGHT] ?
-                                          Information::WALL :
-                                          Information::FREE;
-            return information;
-
-        case Side::LEFT:
-            information.front_left = this->walls.at(pose.position.y).at(pose.position.x - 1)[Side::DOWN] ?
-                                         Information::WALL :
-                                         Information::FREE;
-
-            information.front_right = this->walls.at(pose.position.y).at(pose.position.x - 1)[Side::UP] ?
-                                          Information::WALL :
-                                          Information::FREE;
-            return information;
-
-        case Side::DOWN:
-            information.front_left = this->walls.at(pose.position.y - 1).at(pose.position.x)[Side::RIGHT] ?
-                                         Information::WALL :
-                                         Information::FREE;
-
-            information.front_right = this->walls.at(pose.position.y - 1).at(pose.position.x)[Side::LEFT] ?
-                                          Information::WALL :
-                                          Information::FREE;
-            return information;
+    for (std::uint16_t col = 0; col <= 2 * this->get_width(); col++) {
+        line += "%%";
     }
 
-    return information;
+    os << line << '\n';
+
+    for (std::uint8_t y = this->get_height(); y-- > 0;) {
+        line = "%%";
+
+        for (std::uint16_t col = 0; col < this->get_width(); col++) {
+            line += this->walls.has_wall({{static_cast<uint8_t>(col), y}, Side::RIGHT}) ? "  %%" : "    ";
+        }
+
+        os << line << '\n';
+        line = "%%";
+
+        for (std::uint16_t col = 0; col < this->get_width(); col++) {
+            line += this->walls.has_wall({{static_cast<uint8_t>(col), y}, Side::DOWN}) ? "%%%%" : "  %%";
+        }
+
+        os << line << '\n';
+    }
 }
 
 #endif  // MAZE_CPP
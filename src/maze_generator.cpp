@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+#include "maze_generator.hpp"
+
+namespace {
+/**
+ * @brief Returns the region a cell belongs to, flattening the path to it on the way
+ *
+ * @param regions The parent of each cell, the roots being their own parents
+ * @param cell The index of the cell
+ * @return The index of the root of the region
+ */
+uint32_t find_region(std::vector<uint32_t>& regions, uint32_t cell) {
+    while (regions[cell] != cell) {
+        regions[cell] = regions[regions[cell]];
+        cell = regions[cell];
+    }
+
+    return cell;
+}
+}  // namespace
+
+MazeLayout::MazeLayout(uint8_t width, uint8_t height, bool walls) :
+    width(width), height(height), east(width * height, walls ? 1 : 0), north(width * height, walls ? 1 : 0) { }
+
+bool MazeLayout::has_wall(const GridPose& pose) const {
+    GridPoint front = pose.front().position;
+
+    if (not this->is_inside(pose.position) or not this->is_inside(front)) {
+        return true;
+    }
+
+    switch (pose.orientation) {
+        case Side::RIGHT:
+            return this->east[pose.position.y * this->width + pose.position.x] != 0;
+        case Side::UP:
+            return this->north[pose.position.y * this->width + pose.position.x] != 0;
+        case Side::LEFT:
+            return this->east[front.y * this->width + front.x] != 0;
+        default:
+            return this->north[front.y * this->width + front.x] != 0;
+    }
+}
+
+void MazeLayout::set_wall(const GridPose& pose, bool wall) {
+    GridPoint front = pose.front().position;
+
+    if (not this->is_inside(pose.position) or not this->is_inside(front)) {
+        return;
+    }
+
+    switch (pose.orientation) {
+        case Side::RIGHT:
+            this->east[pose.position.y * this->width + pose.position.x] = wall ? 1 : 0;
+            break;
+        case Side::UP:
+            this->north[pose.position.y * this->width + pose.position.x] = wall ? 1 : 0;
+            break;
+        case Side::LEFT:
+            this->east[front.y * this->width + front.x] = wall ? 1 : 0;
+            break;
+        case Side::DOWN:
+            this->north[front.y * this->width + front.x] = wall ? 1 : 0;
+            break;
+    }
+}
+
+bool MazeLayout::is_inside(const GridPoint& position) const {
+    return position.x < this->width and position.y < this->height;
+}
+
+void MazeLayout::write_text(std::ostream& os) const {
+    std::string text(4 * this->width + 2, '%');
+    text += '\n';
+
+    // The drawing starts at the top row, each cell being 4 characters wide after the 2 of the left border
+    for (uint8_t row = 0; row < this->height; row++) {
+        uint8_t y = this->height - 1 - row;
+
+        text += "%%";
+
+        for (uint8_t x = 0; x < this->width; x++) {
+            text += "  ";
+            text += this->has_wall({{x, y}, Side::RIGHT}) ? "%%" : "  ";
+        }
+
+        text += "\n%%";
+
+        for (uint8_t x = 0; x < this->width; x++) {
+            text += this->has_wall({{x, y}, Side::DOWN}) ? "%%" : "  ";
+            text += "%%";
+        }
+
+        text += '\n';
+    }
+
+    os << text;
+}
+
+MazeGenerator::MazeGenerator(uint64_t seed) : random(seed) { }
+
+MazeLayout MazeGenerator::generate(MazeAlgorithm algorithm, uint8_t width, uint8_t height) {
+    MazeLayout layout(width, height);
+
+    switch (algorithm) {
+        case MazeAlgorithm::BACKTRACKER:
+            this->carve_backtracker(layout);
+            break;
+        case MazeAlgorithm::KRUSKAL: {
+            std::vector<uint32_t> regions(width * height);
+            std::vector<GridPose> walls;
+            std::iota(regions.begin(), regions.end(), 0);
+
+            for (uint8_t y = 0; y < height; y++) {
+                for (uint8_t x = 0; x < width; x++) {
+                    walls.push_back({{x, y}, Side::RIGHT});
+                    walls.push_back({{x, y}, Side::UP});
+                }
+            }
+
+            this->carve_kruskal(layout, regions, walls);
+            break;
+        }
+        case MazeAlgorithm::PRIM:
+            this->carve_prim(layout);
+            break;
+        case MazeAlgorithm::BRAIDED:
+            this->carve_backtracker(layout);
+            this->braid(layout);
+            break;
+        case MazeAlgorithm::COMPETITION:
+            this->carve_competition(layout);
+            break;
+    }
+
+    this->open_start(layout);
+
+    return layout;
+}
+
+uint64_t MazeGenerator::derive_seed(uint64_t seed, uint64_t index) {
+    // SplitMix64, which spreads consecutive indices over unrelated seeds
+    uint64_t value = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+LargeMaze MazeGenerator::generate_large(uint16_t width, uint16_t height, float loop_fraction) {
+    LargeMaze             maze(width, height);
+    std::vector<uint32_t> regions(maze.get_cell_count());
+    std::vector<uint32_t> walls;
+    std::iota(regions.begin(), regions.end(), 0);
+
+    // Walls are stored as twice the index of their cell, plus one for the upper ones, to halve the memory of poses
+    for (uint32_t cell = 0; cell < maze.get_cell_count(); cell++) {
+        if (cell % width + 1 < width) {
+            walls.push_back(2 * cell);
+        }
+
+        if (cell / width + 1 < height) {
+            walls.push_back(2 * cell + 1);
+        }
+    }
+
+    for (std::size_t i = walls.size(); i > 1; i--) {
+        std::swap(walls[i - 1], walls[this->random_below(i)]);
+    }
+
+    auto wall_position = [width](uint32_t wall) {
+        return LargePoint{static_cast<uint16_t>(wall / 2 % width), static_cast<uint16_t>(wall / 2 / width)};
+    };
+
+    for (uint32_t wall : walls) {
+        uint32_t front = wall / 2 + ((wall & 1U) != 0 ? width : 1);
+        uint32_t region = find_region(regions, wall / 2);
+        uint32_t front_region = find_region(regions, front);
+
+        if (region != front_region) {
+            regions[region] = front_region;
+            maze.set_wall(wall_position(wall), (wall & 1U) != 0 ? Side::UP : Side::RIGHT, false);
+        }
+    }
+
+    for (auto count = static_cast<uint32_t>(walls.size() * loop_fraction); count > 0; count--) {
+        uint32_t wall = walls[this->random_below(walls.size())];
+        maze.set_wall(wall_position(wall), (wall & 1U) != 0 ? Side::UP : Side::RIGHT, false);
+    }
+
+    return maze;
+}
+
+void MazeGenerator::carve_backtracker(MazeLayout& layout) {
+    std::vector<uint8_t>   visited(layout.width * layout.height);
+    std::vector<GridPoint> stack = {{0, 0}};
+    visited[0] = 1;
+
+    while (not stack.empty()) {
+        GridPoint position = stack.back();
+        Side      sides[4];
+        uint8_t   side_count = 0;
+
+        for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+            GridPoint next = position + static_cast<Side>(i);
+
+            if (layout.is_inside(next) and visited[next.y * layout.width + next.x] == 0) {
+                sides[side_count++] = static_cast<Side>(i);
+            }
+        }
+
+        if (side_count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        Side      side = sides[this->random_below(side_count)];
+        GridPoint next = position + side;
+
+        layout.set_wall({position, side}, false);
+        visited[next.y * layout.width + next.x] = 1;
+        stack.push_back(next);
+    }
+}
+
+void MazeGenerator::carve_kruskal(MazeLayout& layout, std::vector<uint32_t>& regions, std::vector<GridPose>& walls) {
+    // Fisher-Yates with our own bounded numbers, as std::shuffle differs between standard libraries
+    for (std::size_t i = walls.size(); i > 1; i--) {
+        std::swap(walls[i - 1], walls[this->random_below(i)]);
+    }
+
+    for (const auto& wall : walls) {
+        GridPoint front = wall.front().position;
+
+        if (not layout.is_inside(front)) {
+            continue;
+        }
+
+        uint32_t region = find_region(regions, wall.position.y * layout.width + wall.position.x);
+        uint32_t front_region = find_region(regions, front.y * layout.width + front.x);
+
+        if (region != front_region) {
+            regions[region] = front_region;
+            layout.set_wall(wall, false);
+        }
+    }
+}
+
+void MazeGenerator::carve_prim(MazeLayout& layout) {
+    std::vector<uint8_t>  visited(layout.width * layout.height);
+    std::vector<GridPose> border;
+    GridPoint             start{
+        static_cast<uint8_t>(this->random_below(layout.width)), static_cast<uint8_t>(this->random_below(layout.height))
+    };
+
+    auto visit = [&](const GridPoint& position) {
+        visited[position.y * layout.width + position.x] = 1;
+
+        for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+            GridPoint next = position + static_cast<Side>(i);
+
+            if (layout.is_inside(next) and visited[next.y * layout.width + next.x] == 0) {
+                border.push_back({position, static_cast<Side>(i)});
+            }
+        }
+    };
+
+    visit(start);
+
+    while (not border.empty()) {
+        std::size_t choice = this->random_below(border.size());
+        GridPose    wall = border[choice];
+        GridPoint   next = wall.front().position;
+
+        border[choice] = border.back();
+        border.pop_back();
+
+        if (visited[next.y * layout.width + next.x] != 0) {
+            continue;
+        }
+
+        layout.set_wall(wall, false);
+        visit(next);
+    }
+}
+
+void MazeGenerator::braid(MazeLayout& layout) {
+    for (uint8_t y = 0; y < layout.height; y++) {
+        for (uint8_t x = 0; x < layout.width; x++) {
+            Side    closed[4];
+            uint8_t closed_count = 0;
+
+            for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+                GridPose wall{{x, y}, static_cast<Side>(i)};
+
+                if (layout.has_wall(wall) and layout.is_inside(wall.front().position)) {
+                    closed[closed_count++] = static_cast<Side>(i);
+                }
+            }
+
+            // A dead end has a single opening, so three closed sides, or fewer when it lies on the border
+            uint8_t border_count = 0;
+
+            for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+                border_count += layout.is_inside(GridPoint{x, y} + static_cast<Side>(i)) ? 0 : 1;
+            }
+
+            if (closed_count > 0 and closed_count + border_count == 3) {
+                layout.set_wall({{x, y}, closed[this->random_below(closed_count)]}, false);
+            }
+        }
+    }
+}
+
+void MazeGenerator::carve_competition(MazeLayout& layout) {
+    uint8_t goal_x = (layout.width - 1) / 2;
+    uint8_t goal_y = (layout.height - 1) / 2;
+    auto    in_goal = [&](const GridPoint& position) {
+        return position.x >= goal_x and position.x <= layout.width / 2 and position.y >= goal_y and
+               position.y <= layout.height / 2;
+    };
+
+    std::vector<uint32_t> regions(layout.width * layout.height);
+    std::vector<GridPose> walls;
+    std::vector<GridPose> entries;
+    std::iota(regions.begin(), regions.end(), 0);
+
+    // The goal cells are joined beforehand, so the tree reaches the goal only through the entry chosen below
+    for (uint8_t y = 0; y < layout.height; y++) {
+        for (uint8_t x = 0; x < layout.width; x++) {
+            for (Side side : {Side::RIGHT, Side::UP}) {
+                GridPose  wall{{x, y}, side};
+                GridPoint front = wall.front().position;
+
+                if (not layout.is_inside(front)) {
+                    continue;
+                }
+
+                bool inner = in_goal(wall.position) and in_goal(front);
+
+                if (inner) {
+                    layout.set_wall(wall, false);
+                    regions[find_region(regions, y * layout.width + x)] =
+                        find_region(regions, front.y * layout.width + front.x);
+                } else if (in_goal(wall.position) or in_goal(front)) {
+                    entries.push_back(wall);
+                } else if (not(x == 0 and y == 0 and side == Side::RIGHT)) {
+                    walls.push_back(wall);
+                }
+            }
+        }
+    }
+
+    if (not entries.empty()) {
+        GridPose  entry = entries[this->random_below(entries.size())];
+        GridPoint front = entry.front().position;
+
+        layout.set_wall(entry, false);
+        regions[find_region(regions, entry.position.y * layout.width + entry.position.x)] =
+            find_region(regions, front.y * layout.width + front.x);
+    }
+
+    this->carve_kruskal(layout, regions, walls);
+
+    // Contest mazes have a few loops, so that the shortest route is not the only one
+    for (uint32_t count = 0; count < static_cast<uint32_t>(walls.size() / 20); count++) {
+        layout.set_wall(walls[this->random_below(walls.size())], false);
+    }
+}
+
+void MazeGenerator::open_start(MazeLayout& layout) {
+    // A single row leaves the start no other way out than its right side
+    if (layout.height < 2) {
+        return;
+    }
+
+    layout.set_wall({{0, 0}, Side::RIGHT}, true);
+    layout.set_wall({{0, 0}, Side::UP}, false);
+
+    std::vector<uint8_t>   reached(layout.width * layout.height);
+    std::vector<GridPoint> queue = {{0, 0}};
+    std::size_t            next = 0;
+    reached[0] = 1;
+
+    while (true) {
+        for (; next < queue.size(); next++) {
+            for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+                GridPose  wall{queue[next], static_cast<Side>(i)};
+                GridPoint front = wall.front().position;
+
+                if (not layout.has_wall(wall) and reached[front.y * layout.width + front.x] == 0) {
+                    reached[front.y * layout.width + front.x] = 1;
+                    queue.push_back(front);
+                }
+            }
+        }
+
+        if (queue.size() == reached.size()) {
+            return;
+        }
+
+        // The cells cut off also border the reached cells other than the start, as the start is a corner
+        std::vector<GridPose> bridges;
+
+        for (std::size_t j = 1; j < queue.size(); j++) {
+            for (uint8_t i = Side::RIGHT; i <= Side::DOWN; i++) {
+                GridPose  wall{queue[j], static_cast<Side>(i)};
+                GridPoint front = wall.front().position;
+
+                if (layout.is_inside(front) and reached[front.y * layout.width + front.x] == 0) {
+                    bridges.push_back(wall);
+                }
+            }
+        }
+
+        GridPose  bridge = bridges[this->random_below(bridges.size())];
+        GridPoint front = bridge.front().position;
+
+        layout.set_wall(bridge, false);
+        reached[front.y * layout.width + front.x] = 1;
+        queue.push_back(front);
+    }
+}
+
+uint32_t MazeGenerator::random_below(uint32_t bound) {
+    // Multiplying instead of taking the remainder has no bias worth noting and is the same on every platform
+    return static_cast<uint32_t>(((this->random() >> 32U) * bound) >> 32U);
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "maze_reader.hpp"
+
+std::string_view MazeText::get_row(std::size_t row) const {
+    return this->data.substr(row * this->stride, 4 * this->width + 2);
+}
+
+MazeReader::MazeReader(const std::string& path) : filenames(MappedFile::list_files(path)) { }
+
+bool MazeReader::next(MazeText& text) {
+    std::string_view line;
+
+    // Skips the blank lines before the maze, moving to the next file when the current one is over
+    while (true) {
+        if (this->offset >= this->data.size()) {
+            if (this->files.size() == this->filenames.size()) {
+                return false;
+            }
+
+            this->data = this->files.emplace_back(this->filenames[this->files.size()]).get_data();
+            this->offset = 0;
+            this->line_number = 1;
+            this->maze_count = 0;
+            continue;
+        }
+
+        std::size_t line_end = this->read_line(line);
+
+        if (not line.empty()) {
+            break;
+        }
+
+        this->offset = line_end;
+        this->line_number++;
+    }
+
+    std::size_t start = this->offset;
+    std::size_t start_line = this->line_number;
+    std::size_t row_width = line.size();
+    std::size_t stride = 0;
+    std::size_t row_count = 0;
+
+    if (row_width < 6 or (row_width - 2) % 4 != 0 or (row_width - 2) / 4 > UINT8_MAX) {
+        throw std::runtime_error(this->error(
+            start_line, row_width + 1,
+            "row width must be 4 * width + 2 with a width from 1 to 255, found " + std::to_string(row_width)
+        ));
+    }
+
+    while (this->offset < this->data.size()) {
+        std::size_t line_end = this->read_line(line);
+
+        if (line.empty()) {
+            break;
+        }
+
+        if (line.size() != row_width) {
+            throw std::runtime_error(this->error(
+                this->line_number, std::min(line.size(), row_width) + 1,
+                "expected a row width of " + std::to_string(row_width) + ", found " + std::to_string(line.size())
+            ));
+        }
+
+        const auto* invalid_char =
+            std::find_if(line.begin(), line.end(), [](char character) { return character != '%' and character != ' '; });
+        std::size_t invalid = invalid_char - line.begin();
+
+        if (invalid != line.size()) {
+            throw std::runtime_error(this->error(
+                this->line_number, invalid + 1, std::string("unexpected character '") + line[invalid] + "'"
+            ));
+        }
+
+        // Rows are addressed by a fixed stride, so every row must end the same way as the first one
+        if (row_count == 0) {
+            stride = line_end - this->offset;
+        } else if (line_end - this->offset != stride and line_end != this->data.size()) {
+            throw std::runtime_error(this->error(this->line_number, row_width + 1, "inconsistent line ending"));
+        }
+
+        row_count++;
+        this->offset = line_end;
+        this->line_number++;
+    }
+
+    if (row_count < 3 or row_count % 2 == 0 or (row_count - 1) / 2 > UINT8_MAX) {
+        throw std::runtime_error(this->error(
+            start_line, 1,
+            "row count must be 2 * height + 1 with a height from 1 to 255, found " + std::to_string(row_count)
+        ));
+    }
+
+    text.source = this->filenames[this->files.size() - 1];
+    text.line = start_line;
+    text.index = this->maze_count++;
+    text.data = this->data.substr(start, this->offset - start);
+    text.stride = stride;
+    text.width = static_cast<uint8_t>((row_width - 2) / 4);
+    text.height = static_cast<uint8_t>((row_count - 1) / 2);
+
+    return true;
+}
+
+std::size_t MazeReader::read_line(std::string_view& line) const {
+    const char* begin = this->data.data() + this->offset;
+    const auto* end = static_cast<const char*>(std::memchr(begin, '\n', this->data.size() - this->offset));
+
+    std::size_t line_end = (end == nullptr) ? this->data.size() : end - this->data.data() + 1;
+
+    line = this->data.substr(this->offset, (end == nullptr) ? std::string_view::npos : end - begin);
+
+    if (not line.empty() and line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    return line_end;
+}
+
+std::string MazeReader::error(std::size_t line, std::size_t column, const std::string& message) const {
+    return this->filenames[this->files.size() - 1] + ":" + std::to_string(line) + ":" + std::to_string(column) +
+           ": " + message;
+}
@@ -0,0 +1,176 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "maze_record.hpp"
+
+static_assert(sizeof(MazeRecordHeader) == 16, "The record header must have no padding");
+
+namespace {
+/**
+ * @brief Identification of the format at the start of every record
+ */
+constexpr std::array<char, 3> record_magic = {'M', 'Z', 'B'};
+}  // namespace
+
+std::size_t MazeRecord::get_row_bytes(uint8_t width) {
+    return (width + 7) / 8;
+}
+
+std::size_t MazeRecord::get_size(const MazeRecordHeader& header) {
+    std::size_t size = sizeof(MazeRecordHeader) + 2 * header.height * get_row_bytes(header.width);
+
+    if ((header.flags & MazeRecordHeader::has_evidence) != 0) {
+        size += 4 * header.width * header.height;
+    }
+
+    return size;
+}
+
+MazeRecordHeader MazeRecord::make_header(uint8_t width, uint8_t height) {
+    MazeRecordHeader header{};
+
+    header.magic = record_magic;
+    header.version = version;
+    header.width = width;
+    header.height = height;
+    header.start_orientation = Side::UP;
+    header.goal_position = {static_cast<uint8_t>((width - 1) / 2), static_cast<uint8_t>((height - 1) / 2)};
+    header.goal_width = width / 2 - header.goal_position.x + 1;
+    header.goal_height = height / 2 - header.goal_position.y + 1;
+
+    return header;
+}
+
+std::string_view MazeRecord::get_east_row(uint8_t row) const {
+    std::size_t row_bytes = get_row_bytes(this->width);
+    return this->data.substr(sizeof(MazeRecordHeader) + row * row_bytes, row_bytes);
+}
+
+std::string_view MazeRecord::get_north_row(uint8_t row) const {
+    std::size_t row_bytes = get_row_bytes(this->width);
+    return this->data.substr(sizeof(MazeRecordHeader) + (this->height + row) * row_bytes, row_bytes);
+}
+
+bool MazeRecord::has_wall(const GridPose& pose) const {
+    GridPoint position = pose.position;
+    bool      east = pose.orientation == Side::RIGHT or pose.orientation == Side::LEFT;
+
+    if (pose.orientation == Side::LEFT) {
+        position.x--;
+    } else if (pose.orientation == Side::DOWN) {
+        position.y--;
+    }
+
+    // Unsigned wrap around sends the left and lower borders outside the maze as well
+    if (position.x >= this->width or position.y >= this->height) {
+        return true;
+    }
+
+    std::string_view row = east ? this->get_east_row(position.y) : this->get_north_row(position.y);
+
+    return ((static_cast<uint8_t>(row[position.x / 8]) >> (position.x % 8)) & 1U) != 0;
+}
+
+std::string_view MazeRecord::get_east_evidence() const {
+    if ((this->header.flags & MazeRecordHeader::has_evidence) == 0) {
+        return {};
+    }
+
+    return this->data.substr(
+        sizeof(MazeRecordHeader) + 2 * this->height * get_row_bytes(this->width), 2 * this->width * this->height
+    );
+}
+
+std::string_view MazeRecord::get_north_evidence() const {
+    if ((this->header.flags & MazeRecordHeader::has_evidence) == 0) {
+        return {};
+    }
+
+    return this->data.substr(
+        sizeof(MazeRecordHeader) + 2 * this->height * get_row_bytes(this->width) + 2 * this->width * this->height,
+        2 * this->width * this->height
+    );
+}
+
+GridPose MazeRecord::get_start() const {
+    return {this->header.start_position, static_cast<Side>(this->header.start_orientation)};
+}
+
+MazeRecordReader::MazeRecordReader(const std::string& path) : filenames(MappedFile::list_files(path)) { }
+
+bool MazeRecordReader::next(MazeRecord& record) {
+    while (this->offset >= this->data.size()) {
+        if (this->files.size() == this->filenames.size()) {
+            return false;
+        }
+
+        this->data = this->files.emplace_back(this->filenames[this->files.size()]).get_data();
+        this->offset = 0;
+        this->record_count = 0;
+    }
+
+    const std::string& filename = this->filenames[this->files.size() - 1];
+    std::string        location = filename + ": byte " + std::to_string(this->offset) + ": ";
+    MazeRecordHeader   header{};
+
+    if (this->data.size() - this->offset < sizeof(MazeRecordHeader)) {
+        throw std::runtime_error(location + "truncated record header");
+    }
+
+    std::memcpy(&header, this->data.data() + this->offset, sizeof(MazeRecordHeader));
+
+    if (header.magic != record_magic) {
+        throw std::runtime_error(location + "not a binary maze record");
+    }
+
+    // Version 1 only differs in the meaning of the evidence, which the known maze converts
+    if (header.version == 0 or header.version > MazeRecord::version) {
+        throw std::runtime_error(location + "unsupported record version " + std::to_string(header.version));
+    }
+
+    if (header.width == 0 or header.height == 0) {
+        throw std::runtime_error(location + "empty maze");
+    }
+
+    if (header.start_position.x >= header.width or header.start_position.y >= header.height or
+        header.start_orientation > Side::DOWN) {
+        throw std::runtime_error(location + "start pose outside the maze");
+    }
+
+    if (header.goal_width == 0 or header.goal_height == 0 or
+        header.goal_position.x + header.goal_width > header.width or
+        header.goal_position.y + header.goal_height > header.height) {
+        throw std::runtime_error(location + "goal region outside the maze");
+    }
+
+    std::size_t size = MazeRecord::get_size(header);
+
+    if (this->data.size() - this->offset < size) {
+        throw std::runtime_error(location + "truncated record of " + std::to_string(size) + " bytes");
+    }
+
+    record.source = filename;
+    record.offset = this->offset;
+    record.index = this->record_count++;
+    record.header = header;
+    record.data = this->data.substr(this->offset, size);
+    record.width = header.width;
+    record.height = header.height;
+
+    this->offset += size;
+
+    return true;
+}
+
+bool MazeRecordReader::is_binary(const std::string& path) {
+    std::vector<std::string> filenames = MappedFile::list_files(path);
+
+    if (filenames.empty()) {
+        return false;
+    }
+
+    MappedFile       file(filenames.front());
+    std::string_view data = file.get_data();
+
+    return data.starts_with(std::string_view(record_magic.data(), record_magic.size()));
+}
@@ -0,0 +1,172 @@
+#ifndef MAZE_SNAPSHOT_CPP
+#define MAZE_SNAPSHOT_CPP
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "maze_snapshot.hpp"
+
+template <uint8_t width, uint8_t height>
+MazeSnapshot<width, height>::MazeSnapshot(const KnownMaze<width, height>& base) :
+    GridSize<width, height>(base), base(&base), base_version(base.map_version) {
+    fill_buffer(this->row_chunks, this->get_height(), shared);
+}
+
+template <uint8_t width, uint8_t height>
+void MazeSnapshot<width, height>::update_wall(const GridPose& pose, Information::Existence reading, Sensor sensor) {
+    if (reading == Information::UNKNOWN) {
+        return;
+    }
+
+    int8_t weight = reading == Information::WALL ? this->base->wall_weights[sensor] : this->base->free_weights[sensor];
+
+    this->change_wall(pose, [weight](Evidence& evidence) { KnownMaze<width, height>::add_reading(evidence, weight); });
+}
+
+template <uint8_t width, uint8_t height>
+void MazeSnapshot<width, height>::assume_wall(const GridPose& pose, bool wall) {
+    this->change_wall(pose, [wall](Evidence& evidence) {
+        evidence.belief = wall ? KnownMaze<width, height>::belief_cap : -KnownMaze<width, height>::belief_cap;
+    });
+}
+
+template <uint8_t width, uint8_t height>
+bool MazeSnapshot<width, height>::has_wall(const GridPose& pose) const {
+    this->check_base();
+
+    GridPose edge = WallMap<width, height>::normalized(pose);
+
+    if (not this->is_inside(edge.position)) {
+        return true;
+    }
+
+    uint8_t chunk_index = this->row_chunks[edge.position.y];
+
+    if (chunk_index == shared) {
+        return this->base->walls.has_wall(edge);
+    }
+
+    const Chunk& chunk = *this->chunks[chunk_index];
+    const Row&   walls = edge.orientation == Side::RIGHT ? chunk.east_walls : chunk.north_walls;
+
+    return ((walls[edge.position.x / 64] >> (edge.position.x % 64)) & 1U) != 0;
+}
+
+template <uint8_t width, uint8_t height>
+void MazeSnapshot<width, height>::get_walls(WallMap<width, height>& walls) const {
+    this->check_base();
+
+    walls = this->base->walls;
+    this->for_each_change([&walls](const GridPose& edge, bool wall) { walls.set_wall(edge, wall); });
+}
+
+template <uint8_t width, uint8_t height>
+uint16_t MazeSnapshot<width, height>::get_route_distance(
+    WallMap<width, height>& walls, Costmap<width, height>& costmap
+) const {
+    this->check_base();
+
+    // Walls flipped in the known maze since its last repair are still invalidated in the copy, so both are repaired
+    walls = this->base->walls;
+    costmap = this->base->costmap;
+
+    this->for_each_change([&walls, &costmap](const GridPose& edge, bool wall) {
+        walls.set_wall(edge, wall);
+        costmap.invalidate(edge);
+    });
+
+    costmap.repair(walls);
+    return costmap.get_distance(this->base->start.position);
+}
+
+template <uint8_t width, uint8_t height>
+uint8_t MazeSnapshot<width, height>::get_chunk_count() const {
+    return this->chunks.size();
+}
+
+template <uint8_t width, uint8_t height>
+void MazeSnapshot<width, height>::check_base() const {
+    if (this->base->map_version != this->base_version) {
+        throw std::runtime_error("The walls of the known maze changed after the snapshot was taken");
+    }
+}
+
+template <uint8_t width, uint8_t height>
+MazeSnapshot<width, height>::Chunk& MazeSnapshot<width, height>::get_chunk(uint8_t row) {
+    if (this->row_chunks[row] != shared) {
+        std::shared_ptr<Chunk>& chunk = this->chunks[this->row_chunks[row]];
+
+        if (chunk.use_count() > 1) {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+
+        return *chunk;
+    }
+
+    this->check_base();
+
+    Chunk& chunk = *this->chunks.emplace_back(std::make_shared<Chunk>());
+    auto   first_cell = static_cast<std::ptrdiff_t>(this->index({0, row}));
+
+    fill_buffer(chunk.east_evidence, this->get_width(), Evidence{});
+    fill_buffer(chunk.north_evidence, this->get_width(), Evidence{});
+    std::copy_n(this->base->east_evidence.begin() + first_cell, this->get_width(), chunk.east_evidence.begin());
+    std::copy_n(this->base->north_evidence.begin() + first_cell, this->get_width(), chunk.north_evidence.begin());
+    chunk.east_walls = this->base->walls.get_east_walls(row);
+    chunk.north_walls = this->base->walls.get_north_walls(row);
+
+    this->row_chunks[row] = this->chunks.size() - 1;
+    return chunk;
+}
+
+template <uint8_t width, uint8_t height>
+template <typename Function>
+void MazeSnapshot<width, height>::for_each_change(Function&& function) const {
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        if (this->row_chunks[row] == shared) {
+            continue;
+        }
+
+        const Chunk& chunk = *this->chunks[this->row_chunks[row]];
+
+        for (Side side : {Side::RIGHT, Side::UP}) {
+            const Row& walls = side == Side::RIGHT ? chunk.east_walls : chunk.north_walls;
+            const Row& base_walls = side == Side::RIGHT ? this->base->walls.get_east_walls(row) :
+                                                          this->base->walls.get_north_walls(row);
+
+            for (uint8_t word = 0; word < CellMask<width, height>::row_words; word++) {
+                for (uint64_t bits = walls[word] ^ base_walls[word]; bits != 0; bits &= bits - 1) {
+                    auto col = static_cast<uint8_t>(word * 64 + std::countr_zero(bits));
+                    function(GridPose{{col, row}, side}, ((walls[word] >> (col % 64)) & 1U) != 0);
+                }
+            }
+        }
+    }
+}
+
+template <uint8_t width, uint8_t height>
+template <typename Change>
+void MazeSnapshot<width, height>::change_wall(const GridPose& pose, Change change) {
+    // The borders are walls whatever the readings, as in the known maze
+    if (this->base->walls.is_border(pose)) {
+        return;
+    }
+
+    GridPose  edge = WallMap<width, height>::normalized(pose);
+    Chunk&    chunk = this->get_chunk(edge.position.y);
+    bool      east = edge.orientation == Side::RIGHT;
+    Evidence& evidence = (east ? chunk.east_evidence : chunk.north_evidence)[edge.position.x];
+    Row&      walls = east ? chunk.east_walls : chunk.north_walls;
+    uint64_t  bit = uint64_t{1} << (edge.position.x % 64);
+
+    change(evidence);
+
+    if (evidence.belief > 0) {
+        walls[edge.position.x / 64] |= bit;
+    } else {
+        walls[edge.position.x / 64] &= ~bit;
+    }
+}
+
+#endif  // MAZE_SNAPSHOT_CPP
@@ -1,22 +1,129 @@
 #ifndef MICRAS_CPP
 #define MICRAS_CPP
 
-#include <sstream>
+#include <chrono>
 
 #include "micras.hpp"
+#include "profiler.hpp"
 
 template <std::uint8_t width, std::uint8_t height>
-Micras<width, height>::Micras(const GridPose& start) : pose(start), known_maze(start) { }
+Micras<width, height>::Micras(const GridPose& start, const GridSize<width, height>& size) :
+    pose(start), known_maze(start, size) { }
 
 template <std::uint8_t width, std::uint8_t height>
-void Micras<width, height>::step(const Information& information) {
-    this->known_maze.update(this->pose, information);
-    GridPoint current_goal = this->known_maze.get_current_goal(this->pose.position);
+void Micras<width, height>::reset(const GridPose& start) {
+    this->pose = start;
+    this->known_maze.reset(start);
+    this->route_planned = false;
+    this->route_found = false;
+    this->straight_run = 0;
+    this->motion = {};
+
+    if (this->trace != nullptr) {
+        TraceRun run{};
+        run.width = this->known_maze.get_width();
+        run.height = this->known_maze.get_height();
+        run.start = start;
+        run.strategy = this->known_maze.get_exploration_strategy();
+        run.flags = (this->route_planner != nullptr ? TraceRun::route_planner : 0) |
+                    (this->noisy_sensors ? TraceRun::noisy_sensors : 0);
+
+        // Only rectangular goals can be replayed
+        auto [goal_min, goal_max] = this->known_maze.get_goal().get_bounds();
+        run.goal_position = goal_min;
+        run.goal_width = goal_max.x - goal_min.x + 1;
+        run.goal_height = goal_max.y - goal_min.y + 1;
+        run.id = this->run_id;
+        this->trace->write(run);
+    }
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::load(const MazeRecord& record) {
+    this->known_maze.load(record);
+    this->pose = record.get_start();
+    this->route_planned = false;
+    this->route_found = false;
+    this->straight_run = 0;
+    this->motion = {};
+}
+
+template <std::uint8_t width, std::uint8_t height>
+const Motion& Micras<width, height>::step(const Information& information) {
+    PROFILE_SCOPE(STEP_TIME);
+
+    GridPose                              previous_pose = this->pose;
+    std::chrono::steady_clock::time_point update_start;
+
+    if (this->trace != nullptr) {
+        update_start = std::chrono::steady_clock::now();
+    }
+
+    // Along known corridors the readings are batched into a single update at the end of the straight run
+    bool driving_through = this->can_drive_through(information);
+
+    if (driving_through) {
+        this->known_maze.read(this->pose, information);
+        this->straight_run++;
+    } else {
+        this->known_maze.update(this->pose, information);
+        this->straight_run = 0;
+    }
+
+    std::chrono::steady_clock::duration update_time{};
+
+    if (this->trace != nullptr) {
+        update_time = std::chrono::steady_clock::now() - update_start;
+    }
+
+    GridPoint current_goal = driving_through ? this->pose.front().position : this->get_current_goal();
 
-    if (this->pose.position.direction(current_goal) == this->pose.orientation) {
+    bool moving = this->pose.position.direction(current_goal) == this->pose.orientation;
+
+    // Turns in place before a straight run are part of its motion, as the robot stops only to turn
+    if (moving) {
         this->pose.position = current_goal;
+        this->motion.orientation = this->pose.orientation;
+        this->motion.cells++;
     } else {
+        if (this->motion.cells > 0) {
+            this->motion = {};
+        }
+
         this->pose.orientation = this->pose.position.direction(current_goal);
+        this->motion.orientation = this->pose.orientation;
+        this->motion.turns++;
+    }
+
+    if (this->trace != nullptr) {
+        TraceStep step{};
+        step.flags = (this->known_maze.is_exploring() ? TraceStep::exploring : 0) |
+                     (this->known_maze.is_returning() ? TraceStep::returning : 0) |
+                     (driving_through ? TraceStep::driven_through : 0);
+        step.pose = previous_pose;
+        step.goal = current_goal;
+        step.information = information;
+        step.update_time = trace_time(update_time);
+        this->trace->write(step);
+    }
+
+    return this->motion;
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::bump() {
+    GridPose previous_pose = this->pose;
+    this->pose.position = this->pose.turned_back().front().position;
+    this->straight_run = 0;
+    this->motion = {};
+
+    if (this->trace != nullptr) {
+        TraceStep step{};
+        step.flags = TraceStep::bumped | (this->known_maze.is_exploring() ? TraceStep::exploring : 0) |
+                     (this->known_maze.is_returning() ? TraceStep::returning : 0);
+        step.pose = previous_pose;
+        step.goal = this->pose.position;
+        this->trace->write(step);
     }
 }
 
@@ -26,54 +133,97 @@ const GridPose& Micras<width, height>::get_pose() const {
 }
 
 template <std::uint8_t width, std::uint8_t height>
-std::ostream& operator<<(std::ostream& os, const Micras<width, height>& micras) {
-    std::stringstream buffer;
+uint16_t Micras<width, height>::get_straight_run() const {
+    return this->straight_run;
+}
 
-    buffer << micras.known_maze;
+template <std::uint8_t width, std::uint8_t height>
+const KnownMaze<width, height>& Micras<width, height>::get_known_maze() const {
+    return this->known_maze;
+}
 
-    std::int16_t mouse_pos =
-        (4 * width + 3) * (2 * (micras.pose.position.y) + 1) + 4 * (width - micras.pose.position.x) + 1;
+template <std::uint8_t width, std::uint8_t height>
+float Micras<width, height>::get_route_time() const {
+    return this->route_found ? this->route_planner->get_time() : 0.0F;
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_route_planner(RoutePlanner<width, height>* planner) {
+    this->route_planner = planner;
+    this->route_planned = false;
+    this->route_found = false;
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_exploration_strategy(ExplorationStrategy strategy) {
+    this->known_maze.set_exploration_strategy(strategy);
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_incremental_costmap(bool incremental) {
+    this->known_maze.set_incremental_costmap(incremental);
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_sensor_model(const SensorModel& model) {
+    this->known_maze.set_sensor_model(model);
+    this->noisy_sensors = not model.is_perfect();
+}
 
-    buffer.seekp(-mouse_pos, std::ios_base::cur);
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_goal(const CellMask<width, height>& goal) {
+    this->known_maze.set_goal(goal);
+    this->route_planned = false;
+}
 
-    switch (micras.pose.orientation) {
-        case Side::LEFT:
-            buffer << " <";
-            break;
-        case Side::UP:
-            buffer << "/\\";
-            break;
-        case Side::RIGHT:
-            buffer << "> ";
-            break;
-        case Side::DOWN:
-            buffer << "\\/";
-            break;
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_goal(const GridPoint& position, uint8_t goal_width, uint8_t goal_height) {
+    this->known_maze.set_goal(position, goal_width, goal_height);
+    this->route_planned = false;
+}
+
+template <std::uint8_t width, std::uint8_t height>
+void Micras<width, height>::set_trace(TraceWriter* trace, uint32_t run_id) {
+    this->trace = trace;
+    this->run_id = run_id;
+}
+
+template <std::uint8_t width, std::uint8_t height>
+GridPoint Micras<width, height>::get_current_goal() {
+    PROFILE_SCOPE(CURRENT_GOAL_TIME);
+
+    if (this->route_planner == nullptr or this->known_maze.is_exploring() or this->known_maze.is_returning()) {
+        return this->known_maze.get_current_goal(this->pose.position);
     }
 
-    buffer.seekp(0, std::ios_base::beg);
-
-    while (buffer.peek() != EOF) {
-        char aux = buffer.get();
-
-        if (aux == '%') {
-            os << "█";
-        } else if (aux == '[' or aux == ']') {
-            os << "🮕";
-        } else if (aux == '(') {
-            os << "╒";
-        } else if (aux == ')') {
-            os << "╕";
-        } else if (aux == '>') {
-            os << "🮥";
-        } else if (aux == '<') {
-            os << "🮤";
-        } else {
-            os << aux;
-        }
+    if (not this->route_planned) {
+        this->route_found = this->route_planner->plan(
+            this->known_maze.get_explored_walls(), this->pose, this->known_maze.get_goal()
+        );
+        this->route_planned = true;
+    }
+
+    if (not this->route_found) {
+        return this->known_maze.get_current_goal(this->pose.position);
+    }
+
+    return this->route_planner->get_next(this->pose.position);
+}
+
+template <std::uint8_t width, std::uint8_t height>
+bool Micras<width, height>::can_drive_through(const Information& information) const {
+    const KnownMaze<width, height>& known_maze = this->known_maze;
+    GridPoint                       position = this->pose.position;
+
+    // Reaching the goal or the start changes the phase of the exploration, and a new cell changes the frontier
+    if (not known_maze.is_exploring() or not known_maze.is_visited(position) or
+        known_maze.get_goal().contains(position) or position == known_maze.get_start().position) {
+        return false;
     }
 
-    return os;
+    // Without news the update would leave the map as it is and choose the cell the map already points to
+    return not known_maze.changes_map(this->pose, information) and
+           known_maze.get_current_goal(position) == this->pose.front().position;
 }
 
 #endif  // MICRAS_CPP
@@ -0,0 +1,58 @@
+#ifndef NEIGHBOR_TABLE_CPP
+#define NEIGHBOR_TABLE_CPP
+
+#include "neighbor_table.hpp"
+
+template <uint8_t width, uint8_t height>
+constexpr NeighborTable<width, height>::NeighborTable(const GridSize<width, height>& size) :
+    GridSize<width, height>(size) {
+    if constexpr (GridSize<width, height>::dynamic) {
+        this->neighbors.resize(4 * this->get_cell_count());
+
+        for (uint16_t cell_index = 0; cell_index < this->get_cell_count(); cell_index++) {
+            for (uint8_t side = Side::RIGHT; side <= Side::DOWN; side++) {
+                this->neighbors[4 * cell_index + side] = compute_neighbor(size, cell_index, static_cast<Side>(side));
+            }
+        }
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr uint16_t NeighborTable<width, height>::get_neighbor(uint16_t cell_index, Side side) const {
+    if constexpr (GridSize<width, height>::dynamic) {
+        return this->neighbors[4 * cell_index + side];
+    } else {
+        return fixed_neighbors[4 * cell_index + side];
+    }
+}
+
+template <uint8_t width, uint8_t height>
+constexpr uint16_t NeighborTable<width, height>::compute_neighbor(
+    const GridSize<width, height>& size, uint16_t cell_index, Side side
+) {
+    GridPoint position{
+        static_cast<uint8_t>(cell_index % size.get_width()), static_cast<uint8_t>(cell_index / size.get_width())
+    };
+
+    // The coordinates wrap around to 255 past the bottom and left borders, so one check covers the four borders
+    GridPoint neighbor = position + side;
+
+    return size.is_inside(neighbor) ? size.index(neighbor) : off_grid;
+}
+
+template <uint8_t width, uint8_t height>
+constexpr std::array<uint16_t, 4 * width * height> NeighborTable<width, height>::build_fixed() {
+    std::array<uint16_t, 4 * width * height> table{};
+
+    if constexpr (not GridSize<width, height>::dynamic) {
+        for (uint16_t cell_index = 0; cell_index < width * height; cell_index++) {
+            for (uint8_t side = Side::RIGHT; side <= Side::DOWN; side++) {
+                table[4 * cell_index + side] = compute_neighbor({}, cell_index, static_cast<Side>(side));
+            }
+        }
+    }
+
+    return table;
+}
+
+#endif  // NEIGHBOR_TABLE_CPP
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <string>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "profiler.hpp"
+
+namespace {
+/**
+ * @brief Type to store how each metric is reported
+ */
+struct MetricInfo {
+    /**
+     * @brief Name of the metric
+     */
+    const char* name;
+
+    /**
+     * @brief Whether the samples are times in ticks
+     */
+    bool time;
+};
+
+/**
+ * @brief How each metric is reported, in the order of the metrics
+ */
+constexpr std::array<MetricInfo, METRIC_COUNT> metric_infos = {{
+    {"step_time", true},
+    {"maze_update_time", true},
+    {"wall_update_time", true},
+    {"costmap_time", true},
+    {"best_route_time", true},
+    {"exploration_time", true},
+    {"current_goal_time", true},
+    {"route_plan_time", true},
+    {"flood_fill_cells", false},
+    {"flood_fill_queue", false},
+    {"costmap_resets", false},
+    {"costmap_repairs", false},
+    {"skipped_repairs", false},
+    {"skipped_routes", false},
+    {"skipped_proofs", false},
+    {"wall_flips", false},
+    {"best_route_length", false},
+    {"route_plan_expansions", false},
+}};
+
+/**
+ * @brief Metrics of the threads that already exited
+ */
+std::array<ProfileStatistic, METRIC_COUNT> retired_statistics{};
+
+/**
+ * @brief Mutex protecting the metrics of the threads that already exited
+ */
+std::mutex retired_mutex;
+
+/**
+ * @brief Tick count and time when the program started, used to measure the rate of the cycle counter
+ */
+const uint64_t                              start_ticks = Profiler::read_ticks();
+const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+/**
+ * @brief Adds the samples of a metric to another one
+ *
+ * @param statistic The statistic receiving the samples
+ * @param other The statistic whose samples are added
+ */
+void merge(ProfileStatistic& statistic, const ProfileStatistic& other) {
+    statistic.count += other.count;
+    statistic.total += other.total;
+    statistic.maximum = std::max(statistic.maximum, other.maximum);
+}
+}  // namespace
+
+void ProfileReport::write_json(std::ostream& os) const {
+    double ns_per_tick = 1e9 / this->ticks_per_second;
+
+    os << "{\n  \"ticks_per_second\": " << std::fixed << std::setprecision(0) << this->ticks_per_second
+       << ",\n  \"metrics\": {";
+
+    for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+        const ProfileStatistic& statistic = this->statistics[i];
+        double                  scale = metric_infos[i].time ? ns_per_tick : 1.0;
+        double                  mean = statistic.count > 0 ? statistic.total * scale / statistic.count : 0.0;
+
+        int                     precision = metric_infos[i].time ? 1 : 0;
+
+        os << (i > 0 ? "," : "") << "\n    \"" << metric_infos[i].name << "\": {\"unit\": \""
+           << (metric_infos[i].time ? "ns" : "count") << "\", \"count\": " << statistic.count
+           << ", \"total\": " << std::setprecision(precision) << statistic.total * scale
+           << ", \"mean\": " << std::setprecision(3) << mean << ", \"max\": " << std::setprecision(precision)
+           << statistic.maximum * scale << "}";
+    }
+
+    os << "\n  }\n}\n";
+}
+
+void ProfileReport::write_table(std::ostream& os) const {
+    double us_per_tick = 1e6 / this->ticks_per_second;
+    double step_total = this->statistics[STEP_TIME].total;
+
+    os << std::left << std::setw(26) << "metric" << std::right << std::setw(12) << "count" << std::setw(16) << "total"
+       << std::setw(12) << "mean" << std::setw(12) << "max" << std::setw(10) << "step %" << '\n';
+
+    for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+        const ProfileStatistic& statistic = this->statistics[i];
+        bool                    time = metric_infos[i].time;
+        double                  scale = time ? us_per_tick : 1.0;
+        double                  mean = statistic.count > 0 ? statistic.total * scale / statistic.count : 0.0;
+        std::string             name = std::string(metric_infos[i].name) + (time ? " [us]" : "");
+
+        os << std::left << std::setw(26) << name << std::right << std::setw(12) << statistic.count << std::fixed
+           << std::setprecision(time ? 1 : 0) << std::setw(16) << statistic.total * scale << std::setprecision(3)
+           << std::setw(12) << mean << std::setprecision(time ? 3 : 0) << std::setw(12) << statistic.maximum * scale;
+
+        // Nested scopes are counted in their parents too, so the shares do not add up to the whole step
+        if (time and step_total > 0) {
+            os << std::setprecision(1) << std::setw(10) << 100.0 * statistic.total / step_total;
+        }
+
+        os << '\n';
+    }
+}
+
+Profiler::~Profiler() {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+
+    for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+        merge(retired_statistics[i], this->statistics[i]);
+    }
+}
+
+Profiler& Profiler::get() {
+    thread_local Profiler profiler;
+    return profiler;
+}
+
+void Profiler::add(ProfileMetric metric, uint64_t value) {
+    ProfileStatistic& statistic = this->statistics[metric];
+
+    statistic.count++;
+    statistic.total += value;
+    statistic.maximum = std::max(statistic.maximum, value);
+}
+
+ProfileReport Profiler::collect() {
+    ProfileReport report{};
+
+    {
+        std::lock_guard<std::mutex> lock(retired_mutex);
+        report.statistics = retired_statistics;
+    }
+
+    for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+        merge(report.statistics[i], get().statistics[i]);
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    report.ticks_per_second = static_cast<double>(read_ticks() - start_ticks) / elapsed;
+
+    return report;
+}
+
+void Profiler::clear() {
+    {
+        std::lock_guard<std::mutex> lock(retired_mutex);
+        retired_statistics = {};
+    }
+
+    get().statistics = {};
+}
+
+uint64_t Profiler::read_ticks() {
+#if defined(__x86_64__) or defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+ProfileTimer::ProfileTimer(ProfileMetric metric) : metric(metric), start(Profiler::read_ticks()) { }
+
+ProfileTimer::~ProfileTimer() {
+    Profiler::get().add(this->metric, Profiler::read_ticks() - this->start);
+}
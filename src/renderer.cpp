@@ -0,0 +1,203 @@
+#ifndef RENDERER_CPP
+#define RENDERER_CPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "renderer.hpp"
+
+/**
+ * @brief Glyphs of the elements of the maze, each two columns wide
+ */
+namespace glyphs {
+/**
+ * @brief Builds a glyph from its text
+ *
+ * @param text The UTF-8 text, at most 8 bytes long
+ * @return The glyph
+ */
+constexpr std::array<char, 8> make(std::string_view text) {
+    std::array<char, 8> result{};
+    std::copy(text.begin(), text.end(), result.begin());
+    return result;
+}
+
+constexpr std::array<char, 8> wall = make("██");
+constexpr std::array<char, 8> open = make("  ");
+constexpr std::array<char, 8> goal = make("🮕🮕");
+constexpr std::array<char, 8> start = make("╒╕");
+constexpr std::array<char, 8> unreachable = make("--");
+constexpr std::array<std::array<char, 8>, 4> robot = {make("🮥 "), make("/\\"), make(" 🮤"), make("\\/")};
+}  // namespace glyphs
+
+template <uint8_t width, uint8_t height>
+Renderer<width, height>::Renderer(const GridSize<width, height>& size, float frame_rate) :
+    GridSize<width, height>(size) {
+    std::size_t glyph_count = (2 * this->get_width() + 1) * (2 * this->get_height() + 1);
+
+    fill_buffer(this->frame, glyph_count, Glyph{});
+    fill_buffer(this->previous_frame, glyph_count, Glyph{});
+
+    // Enough for a whole frame with a cursor move before every glyph, so drawing never allocates
+    this->output.reserve(glyph_count * (sizeof(Glyph) + 12) + 16);
+
+    if (frame_rate > 0.0F) {
+        this->frame_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(1.0F / frame_rate)
+        );
+    }
+}
+
+template <uint8_t width, uint8_t height>
+bool Renderer<width, height>::draw(
+    std::ostream& os, const KnownMaze<width, height>& maze, const GridPose& pose, bool force
+) {
+    auto now = std::chrono::steady_clock::now();
+
+    if (not force and this->has_previous_frame and now - this->last_frame_time < this->frame_period) {
+        return false;
+    }
+
+    this->last_frame_time = now;
+    this->render(maze, pose);
+    this->output.clear();
+
+    if (not this->has_previous_frame) {
+        this->output += "\x1b[2J";
+    }
+
+    std::size_t columns = 2 * this->get_width() + 1;
+    std::size_t rows = 2 * this->get_height() + 1;
+
+    for (std::size_t row = 0; row < rows; row++) {
+        // Consecutive changed glyphs of a row are written after a single cursor move
+        bool cursor_placed = false;
+
+        for (std::size_t col = 0; col < columns; col++) {
+            std::size_t i = row * columns + col;
+
+            if (this->has_previous_frame and this->frame[i] == this->previous_frame[i]) {
+                cursor_placed = false;
+                continue;
+            }
+
+            if (not cursor_placed) {
+                this->move_cursor(row, 2 * col);
+                cursor_placed = true;
+            }
+
+            this->append(this->frame[i]);
+        }
+    }
+
+    // Leaves the cursor below the maze, so other output does not overwrite it
+    this->move_cursor(rows, 0);
+
+    os.write(this->output.data(), static_cast<std::streamsize>(this->output.size()));
+    os.flush();
+
+    std::swap(this->frame, this->previous_frame);
+    this->has_previous_frame = true;
+
+    return true;
+}
+
+template <uint8_t width, uint8_t height>
+void Renderer<width, height>::write(std::ostream& os, const KnownMaze<width, height>& maze, const GridPose& pose) {
+    this->render(maze, pose);
+    this->output.clear();
+
+    std::size_t columns = 2 * this->get_width() + 1;
+
+    for (std::size_t i = 0; i < columns * (2 * this->get_height() + 1); i++) {
+        this->append(this->frame[i]);
+
+        if ((i + 1) % columns == 0) {
+            this->output += '\n';
+        }
+    }
+
+    os.write(this->output.data(), static_cast<std::streamsize>(this->output.size()));
+}
+
+template <uint8_t width, uint8_t height>
+void Renderer<width, height>::invalidate() {
+    this->has_previous_frame = false;
+}
+
+template <uint8_t width, uint8_t height>
+void Renderer<width, height>::render(const KnownMaze<width, height>& maze, const GridPose& pose) {
+    const WallMap<width, height>& walls = maze.get_walls();
+    std::size_t                   columns = 2 * this->get_width() + 1;
+    std::size_t                   top = 2 * this->get_height();
+
+    // Posts are always walls and the walls of each cell are set from its right and upper sides
+    for (std::size_t row = 0; row <= top; row += 2) {
+        for (std::size_t col = 0; col < columns; col++) {
+            this->frame[row * columns + col] = glyphs::wall;
+        }
+    }
+
+    for (uint8_t y = 0; y < this->get_height(); y++) {
+        std::size_t row = top - (2 * y + 1);
+
+        this->frame[row * columns] = glyphs::wall;
+
+        for (uint8_t x = 0; x < this->get_width(); x++) {
+            this->frame[row * columns + 2 * x + 1] = cell_glyph(maze, pose, {x, y});
+            this->frame[row * columns + 2 * x + 2] =
+                walls.has_wall({{x, y}, Side::RIGHT}) ? glyphs::wall : glyphs::open;
+            this->frame[(row - 1) * columns + 2 * x + 1] =
+                walls.has_wall({{x, y}, Side::UP}) ? glyphs::wall : glyphs::open;
+        }
+    }
+}
+
+template <uint8_t width, uint8_t height>
+Renderer<width, height>::Glyph Renderer<width, height>::cell_glyph(
+    const KnownMaze<width, height>& maze, const GridPose& pose, const GridPoint& position
+) {
+    if (position == pose.position) {
+        return glyphs::robot[pose.orientation];
+    }
+
+    if (position == maze.get_start().position) {
+        return glyphs::start;
+    }
+
+    if (maze.get_goal().contains(position)) {
+        return glyphs::goal;
+    }
+
+    uint16_t cost = maze.get_cost(position);
+
+    if (cost == 0xFFFF) {
+        return glyphs::unreachable;
+    }
+
+    // Costs are shown in two columns, the larger ones by their last two digits
+    Glyph glyph{};
+    glyph[0] = static_cast<char>('0' + cost / 10 % 10);
+    glyph[1] = static_cast<char>('0' + cost % 10);
+
+    return glyph;
+}
+
+template <uint8_t width, uint8_t height>
+void Renderer<width, height>::move_cursor(std::size_t row, std::size_t column) {
+    std::array<char, 20> digits{};
+
+    this->output += "\x1b[";
+    this->output.append(digits.data(), std::to_chars(digits.begin(), digits.end(), row + 1).ptr);
+    this->output += ';';
+    this->output.append(digits.data(), std::to_chars(digits.begin(), digits.end(), column + 1).ptr);
+    this->output += 'H';
+}
+
+template <uint8_t width, uint8_t height>
+void Renderer<width, height>::append(const Glyph& glyph) {
+    this->output.append(glyph.data(), strnlen(glyph.data(), glyph.size()));
+}
+
+#endif  // RENDERER_CPP
@@ -0,0 +1,55 @@
+#ifndef RING_BUFFER_CPP
+#define RING_BUFFER_CPP
+
+#include <algorithm>
+#include <bit>
+
+#include "ring_buffer.hpp"
+
+template <typename T>
+RingBuffer<T>::RingBuffer(std::size_t capacity) :
+    items(std::bit_ceil(std::max<std::size_t>(capacity, 1))), mask(this->items.size() - 1) { }
+
+template <typename T>
+bool RingBuffer<T>::push(const T& item) {
+    std::size_t head = this->head.load(std::memory_order_relaxed);
+
+    if (head - this->cached_tail == this->items.size()) {
+        this->cached_tail = this->tail.load(std::memory_order_acquire);
+
+        if (head - this->cached_tail == this->items.size()) {
+            return false;
+        }
+    }
+
+    this->items[head & this->mask] = item;
+    this->head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+std::size_t RingBuffer<T>::pop(T* items, std::size_t count) {
+    std::size_t tail = this->tail.load(std::memory_order_relaxed);
+
+    if (this->cached_head - tail < count) {
+        this->cached_head = this->head.load(std::memory_order_acquire);
+    }
+
+    count = std::min(count, this->cached_head - tail);
+
+    for (std::size_t i = 0; i < count; i++) {
+        items[i] = this->items[(tail + i) & this->mask];
+    }
+
+    this->tail.store(tail + count, std::memory_order_release);
+
+    return count;
+}
+
+template <typename T>
+std::size_t RingBuffer<T>::get_capacity() const {
+    return this->items.size();
+}
+
+#endif  // RING_BUFFER_CPP
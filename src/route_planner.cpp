@@ -0,0 +1,187 @@
+#ifndef ROUTE_PLANNER_CPP
+#define ROUTE_PLANNER_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#include "profiler.hpp"
+#include "route_planner.hpp"
+
+template <uint8_t width, uint8_t height>
+RoutePlanner<width, height>::RoutePlanner(const MotionProfile& profile, const GridSize<width, height>& size) :
+    GridSize<width, height>(size), profile(profile), queue(4U * size.get_cell_count()) {
+    fill_buffer(this->times, 4U * this->get_cell_count(), std::numeric_limits<float>::infinity());
+    fill_buffer(this->edges, 4U * this->get_cell_count(), Edge{});
+    fill_buffer(this->route, this->get_cell_count(), GridPoint{});
+    fill_buffer(this->route_step, this->get_cell_count(), uint16_t{0xFFFF});
+}
+
+template <uint8_t width, uint8_t height>
+bool RoutePlanner<width, height>::plan(
+    const WallMap<width, height>& walls, const GridPose& start, const CellMask<width, height>& goal
+) {
+    PROFILE_SCOPE(ROUTE_PLAN_TIME);
+
+    std::fill(this->times.begin(), this->times.end(), std::numeric_limits<float>::infinity());
+    this->queue.clear();
+
+    State start_state = this->state(start);
+    this->times[start_state] = 0;
+    this->edges[start_state] = {IndexedHeap<state_count>::none, 0, start.orientation};
+    this->queue.push(start_state, 0);
+
+    [[maybe_unused]] uint32_t expansion_count = 0;
+
+    while (not this->queue.empty()) {
+        State    current = this->queue.pop();
+        GridPose current_pose = this->pose(current);
+        float    time = this->times[current];
+
+        expansion_count++;
+
+        if (goal.contains(current_pose.position)) {
+            PROFILE_SAMPLE(ROUTE_PLAN_EXPANSIONS, expansion_count);
+            this->build_route(current);
+            this->route_time = time;
+            return true;
+        }
+
+        this->relax(current, current_pose.turned_left(), time + this->profile.turn_time, 0, current_pose.orientation);
+        this->relax(current, current_pose.turned_right(), time + this->profile.turn_time, 0, current_pose.orientation);
+
+        GridPoint position = current_pose.position;
+
+        for (uint16_t length = 1; not walls.has_wall({position, current_pose.orientation}); length++) {
+            position = position + current_pose.orientation;
+            this->relax(
+                current, {position, current_pose.orientation},
+                time + this->run_time(length * this->profile.cell_size, this->profile.max_speed), length,
+                current_pose.orientation
+            );
+        }
+
+        // A zig-zag alternating a side move with the current orientation is run as a diagonal
+        for (Side first_move : {current_pose.turned_left().orientation, current_pose.turned_right().orientation}) {
+            position = current_pose.position;
+            Side move = first_move;
+
+            for (uint16_t length = 1; not walls.has_wall({position, move}); length++) {
+                position = position + move;
+
+                if (length >= 2) {
+                    float distance = length * this->profile.cell_size * std::numbers::sqrt2_v<float> / 2;
+
+                    this->relax(
+                        current, {position, move},
+                        time + 2 * this->profile.diagonal_turn_time +
+                            this->run_time(distance, this->profile.max_diagonal_speed),
+                        length, first_move
+                    );
+                }
+
+                move = (move == first_move) ? current_pose.orientation : first_move;
+            }
+        }
+    }
+
+    PROFILE_SAMPLE(ROUTE_PLAN_EXPANSIONS, expansion_count);
+    return false;
+}
+
+template <uint8_t width, uint8_t height>
+GridPoint RoutePlanner<width, height>::get_next(const GridPoint& position) const {
+    uint16_t step = this->route_step.at(this->index(position));
+
+    if (step == 0xFFFF or step + 1 >= this->route_length) {
+        return position;
+    }
+
+    return this->route.at(step + 1);
+}
+
+template <uint8_t width, uint8_t height>
+float RoutePlanner<width, height>::get_time() const {
+    return this->route_time;
+}
+
+template <uint8_t width, uint8_t height>
+void RoutePlanner<width, height>::set_profile(const MotionProfile& profile) {
+    this->profile = profile;
+}
+
+template <uint8_t width, uint8_t height>
+void RoutePlanner<width, height>::relax(State parent, const GridPose& pose, float time, uint16_t length, Side first_move) {
+    State next = this->state(pose);
+
+    if (time >= this->times[next]) {
+        return;
+    }
+
+    this->times[next] = time;
+    this->edges[next] = {parent, length, first_move};
+    this->queue.push(next, time);
+}
+
+template <uint8_t width, uint8_t height>
+void RoutePlanner<width, height>::build_route(State last) {
+    for (uint16_t step = 0; step < this->route_length; step++) {
+        this->route_step[this->index(this->route[step])] = 0xFFFF;
+    }
+
+    this->route_length = 0;
+    GridPoint position = this->pose(last).position;
+    this->route[this->route_length++] = position;
+
+    // The cells are collected from the end of the route and reversed afterwards
+    for (State current = last; this->edges[current].parent != IndexedHeap<state_count>::none;
+         current = this->edges[current].parent) {
+        const Edge& edge = this->edges[current];
+        Side        parent_orientation = this->pose(edge.parent).orientation;
+
+        for (uint16_t move = edge.length; move > 0 and this->route_length < this->get_cell_count(); move--) {
+            Side side = (move % 2 == 1) ? edge.first_move : parent_orientation;
+            position = GridPose{position, side}.turned_back().front().position;
+            this->route[this->route_length++] = position;
+        }
+    }
+
+    std::reverse(this->route.begin(), this->route.begin() + this->route_length);
+
+    for (uint16_t step = 0; step < this->route_length; step++) {
+        this->route_step[this->index(this->route[step])] = step;
+    }
+}
+
+template <uint8_t width, uint8_t height>
+float RoutePlanner<width, height>::run_time(float distance, float max_speed) const {
+    float entry_speed = this->profile.turn_speed;
+    float acceleration = this->profile.acceleration;
+    float ramp_distance = (max_speed * max_speed - entry_speed * entry_speed) / (2 * acceleration);
+
+    // Triangular profile when there is no room to reach the maximum speed
+    if (2 * ramp_distance >= distance) {
+        float peak_speed = std::sqrt(entry_speed * entry_speed + acceleration * distance);
+        return 2 * (peak_speed - entry_speed) / acceleration;
+    }
+
+    return 2 * (max_speed - entry_speed) / acceleration + (distance - 2 * ramp_distance) / max_speed;
+}
+
+template <uint8_t width, uint8_t height>
+RoutePlanner<width, height>::State RoutePlanner<width, height>::state(const GridPose& pose) const {
+    return 4 * this->index(pose.position) + pose.orientation;
+}
+
+template <uint8_t width, uint8_t height>
+GridPose RoutePlanner<width, height>::pose(State state) const {
+    uint16_t cell = state / 4;
+
+    return {
+        {static_cast<uint8_t>(cell % this->get_width()), static_cast<uint8_t>(cell / this->get_width())},
+        static_cast<Side>(state % 4)
+    };
+}
+
+#endif  // ROUTE_PLANNER_CPP
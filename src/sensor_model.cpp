@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "sensor_model.hpp"
+
+namespace {
+/**
+ * @brief Readings of the information, in the order of the sensors
+ */
+constexpr std::array<Information::Existence Information::*, SensorModel::sensor_count> readings = {
+    &Information::left, &Information::front_left, &Information::front, &Information::front_right, &Information::right
+};
+
+/**
+ * @brief Parses a probability
+ *
+ * @param text The probability
+ * @return The probability, from zero to one half
+ */
+float parse_probability(const std::string& text) {
+    float value = std::stof(text);
+
+    // A sensor wrong more than half of the time could be trusted by reading it the other way around
+    if (value < 0.0F or value > 0.5F) {
+        throw std::runtime_error("Sensor error probabilities go from 0 to 0.5, found " + text);
+    }
+
+    return value;
+}
+}  // namespace
+
+double random_unit(std::mt19937_64& random) {
+    // The 53 upper bits fill the mantissa of a double exactly
+    return static_cast<double>(random() >> 11U) * 0x1.0p-53;
+}
+
+SensorModel::SensorModel(const SensorNoise& noise, float range_noise) : range_noise(range_noise) {
+    this->noise.fill(noise);
+}
+
+SensorModel SensorModel::parse(const std::string& text) {
+    std::size_t first = text.find(',');
+
+    if (first == std::string::npos) {
+        throw std::runtime_error("Expected the sensor noise as FALSE_POSITIVE,FALSE_NEGATIVE[,RANGE], found " + text);
+    }
+
+    std::size_t second = text.find(',', first + 1);
+    SensorNoise noise{
+        parse_probability(text.substr(0, first)), parse_probability(text.substr(first + 1, second - first - 1))
+    };
+
+    return SensorModel(noise, second == std::string::npos ? 0.0F : parse_probability(text.substr(second + 1)));
+}
+
+void SensorModel::set_noise(Sensor sensor, const SensorNoise& noise) {
+    this->noise.at(sensor) = noise;
+}
+
+SensorNoise SensorModel::get_noise(Sensor sensor) const {
+    SensorNoise noise = this->noise.at(sensor);
+    float       range_noise = this->range_noise * static_cast<float>(get_range(sensor));
+
+    noise.false_positive = std::min(noise.false_positive + range_noise, 0.5F);
+    noise.false_negative = std::min(noise.false_negative + range_noise, 0.5F);
+
+    return noise;
+}
+
+uint8_t SensorModel::get_range(Sensor sensor) {
+    // The diagonal sensors see the walls on the sides of the next cell
+    return sensor == Sensor::FRONT_LEFT_SENSOR or sensor == Sensor::FRONT_RIGHT_SENSOR ? 1 : 0;
+}
+
+bool SensorModel::is_perfect() const {
+    return this->range_noise <= 0.0F and std::all_of(this->noise.begin(), this->noise.end(), [](const auto& noise) {
+               return noise.false_positive <= 0.0F and noise.false_negative <= 0.0F;
+           });
+}
+
+Information SensorModel::apply(const Information& information, std::mt19937_64& random) const {
+    Information noisy = information;
+
+    for (uint8_t i = 0; i < sensor_count; i++) {
+        Information::Existence& reading = noisy.*readings[i];
+
+        if (reading == Information::UNKNOWN) {
+            continue;
+        }
+
+        SensorNoise noise = this->get_noise(static_cast<Sensor>(i));
+        float       error = reading == Information::WALL ? noise.false_negative : noise.false_positive;
+
+        // Sensors without noise draw as well, so the noise of one sensor does not shift the draws of the others
+        if (random_unit(random) < error) {
+            reading = reading == Information::WALL ? Information::FREE : Information::WALL;
+        }
+    }
+
+    return noisy;
+}
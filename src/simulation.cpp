@@ -0,0 +1,117 @@
+#ifndef SIMULATION_CPP
+#define SIMULATION_CPP
+
+#include <stdexcept>
+
+#include "simulation.hpp"
+
+template <uint8_t width, uint8_t height>
+Simulation<width, height>::Simulation(const GridPose& start, const GridSize<width, height>& size) :
+    start(start), micras(start, size), route_planner({}, size) { }
+
+template <uint8_t width, uint8_t height>
+EpisodeResult Simulation<width, height>::run(const Maze<width, height>& maze, uint32_t max_steps) {
+    EpisodeResult                   result;
+    const KnownMaze<width, height>& known_maze = this->micras.get_known_maze();
+
+    if (maze.get_width() != known_maze.get_width() or maze.get_height() != known_maze.get_height()) {
+        throw std::runtime_error("The maze size differs from the size of the simulation");
+    }
+
+    // The planner is lent again on every run, so copies of the simulation do not share it
+    this->micras.set_route_planner(this->use_route_planner ? &this->route_planner : nullptr);
+    this->micras.reset(this->start);
+
+    uint32_t same_pose_steps = 0;
+
+    while (result.steps < max_steps) {
+        GridPose    pose = this->micras.get_pose();
+        GridPoint   position = pose.position;
+        Information information = maze.get_information(this->micras.get_pose());
+        bool        blocked = information.front == Information::WALL;
+
+        if (not this->sensor_model.is_perfect()) {
+            information = this->sensor_model.apply(information, this->random);
+        }
+
+        const Motion& motion = this->micras.step(information);
+        result.steps++;
+
+        // A motion starts with a single turn or cell, the following steps only extend it
+        result.motions += motion.turns + motion.cells == 1 ? 1 : 0;
+
+        // Walls read free by mistake are found by hitting them, which costs the step of the move
+        if (blocked and this->micras.get_pose().position != position) {
+            this->micras.bump();
+            result.collisions++;
+
+            // The fast run follows a route fixed after the exploration, so it would hit the same wall again
+            if (not known_maze.is_exploring()) {
+                result.route_blocked = true;
+                break;
+            }
+        } else if (this->slip_probability > 0.0F and this->micras.get_pose().position != position and
+                   random_unit(this->random) < this->slip_probability) {
+            this->micras.bump();
+            result.slips++;
+        }
+
+        // A robot neither moving nor turning would only burn the remaining steps, so the run is stopped right away
+        same_pose_steps = this->micras.get_pose() == pose ? same_pose_steps + 1 : 0;
+
+        if (same_pose_steps >= stuck_steps) {
+            result.stuck = true;
+            result.stuck_pose = pose;
+            break;
+        }
+
+        if (known_maze.is_exploring()) {
+            result.exploration_steps++;
+            result.map_updates += this->micras.get_straight_run() == 0 ? 1 : 0;
+            continue;
+        }
+
+        if (result.fast_run_steps == 0) {
+            result.route_cost = known_maze.get_cost(position);
+            result.route_proven = known_maze.is_route_proven();
+        }
+
+        result.fast_run_steps++;
+
+        if (known_maze.get_goal().contains(this->micras.get_pose().position)) {
+            result.route_time = this->micras.get_route_time();
+            result.finished = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
+template <uint8_t width, uint8_t height>
+void Simulation<width, height>::set_sensor_model(const SensorModel& model) {
+    this->sensor_model = model;
+    this->micras.set_sensor_model(model);
+}
+
+template <uint8_t width, uint8_t height>
+void Simulation<width, height>::set_slip_probability(float probability) {
+    this->slip_probability = probability;
+}
+
+template <uint8_t width, uint8_t height>
+void Simulation<width, height>::set_route_planner(bool enabled) {
+    this->use_route_planner = enabled;
+}
+
+template <uint8_t width, uint8_t height>
+void Simulation<width, height>::set_seed(uint64_t seed) {
+    this->random.seed(seed);
+}
+
+template <uint8_t width, uint8_t height>
+Micras<width, height>& Simulation<width, height>::get_micras() {
+    return this->micras;
+}
+
+#endif  // SIMULATION_CPP
@@ -0,0 +1,120 @@
+#include <algorithm>
+
+#include "thread_pool.hpp"
+
+namespace {
+/**
+ * @brief Index of the worker running the current thread, if any
+ */
+thread_local std::size_t current_worker = static_cast<std::size_t>(-1);
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < thread_count; i++) {
+        this->workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (std::size_t i = 0; i < thread_count; i++) {
+        this->threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    this->wait();
+
+    {
+        std::lock_guard<std::mutex> lock(this->state_mutex);
+        this->stopping = true;
+    }
+
+    this->task_available.notify_all();
+
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    std::size_t index = this->next_worker++ % this->workers.size();
+
+    this->pending_count++;
+
+    {
+        // Counting the task before queueing it keeps a thief from taking it while it is still uncounted
+        std::lock_guard<std::mutex> state_lock(this->state_mutex);
+        this->queued_count++;
+
+        std::lock_guard<std::mutex> worker_lock(this->workers[index]->mutex);
+        this->workers[index]->tasks.push_back(std::move(task));
+    }
+
+    this->task_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(this->state_mutex);
+    this->all_done.wait(lock, [this]() { return this->pending_count == 0; });
+}
+
+std::size_t ThreadPool::get_thread_count() const {
+    return this->threads.size();
+}
+
+std::size_t ThreadPool::get_worker_index() const {
+    return current_worker < this->threads.size() ? current_worker : this->threads.size();
+}
+
+void ThreadPool::run(std::size_t index) {
+    current_worker = index;
+
+    while (true) {
+        std::function<void()> task;
+
+        if (this->take_task(index, task)) {
+            task();
+
+            if (--this->pending_count == 0) {
+                std::lock_guard<std::mutex> lock(this->state_mutex);
+                this->all_done.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->state_mutex);
+        this->task_available.wait(lock, [this]() { return this->stopping or this->queued_count > 0; });
+
+        if (this->stopping and this->queued_count == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::take_task(std::size_t index, std::function<void()>& task) {
+    for (std::size_t i = 0; i < this->workers.size(); i++) {
+        Worker& worker = *this->workers[(index + i) % this->workers.size()];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+
+        if (worker.tasks.empty()) {
+            continue;
+        }
+
+        // The owner takes its most recent task, thieves take the oldest one
+        if (i == 0) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        } else {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+
+        this->queued_count--;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "trace.hpp"
+
+static_assert(sizeof(TraceRun) == 16, "The run record must have no padding");
+static_assert(sizeof(TraceStep) == 16, "The step record must have no padding");
+static_assert(sizeof(TraceRecord) == 16, "Both records must have the same size");
+
+namespace {
+/**
+ * @brief Type to store the header at the start of a trace file
+ */
+struct TraceHeader {
+    /**
+     * @brief Identification of the format, "MZT"
+     */
+    std::array<char, 3> magic;
+
+    /**
+     * @brief Version of the format
+     */
+    uint8_t version;
+
+    /**
+     * @brief Size of each record in bytes
+     */
+    uint8_t record_size;
+
+    /**
+     * @brief Unused bytes, kept at zero
+     */
+    std::array<uint8_t, 3> reserved;
+};
+
+/**
+ * @brief Identification of the format at the start of every trace
+ */
+constexpr std::array<char, 3> trace_magic = {'M', 'Z', 'T'};
+
+/**
+ * @brief Current version of the format, 2 since the run records store the goal
+ */
+constexpr uint8_t trace_version = 2;
+
+/**
+ * @brief Number of records written to the file at once by the writer thread
+ */
+constexpr std::size_t write_batch_size = 4096;
+
+/**
+ * @brief Time the writer thread sleeps when there is nothing to write
+ */
+constexpr std::chrono::milliseconds write_period{1};
+}  // namespace
+
+TraceWriter::TraceWriter(const std::string& filename, std::size_t capacity) :
+    filename(filename), file(filename, std::ios::binary), buffer(capacity) {
+    if (not this->file) {
+        throw std::runtime_error("Could not create file " + filename);
+    }
+
+    TraceHeader header{trace_magic, trace_version, sizeof(TraceRecord), {}};
+    this->file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (not this->file) {
+        throw std::runtime_error("Could not write the trace file " + filename);
+    }
+
+    this->writer = std::thread(&TraceWriter::run, this);
+}
+
+TraceWriter::~TraceWriter() {
+    this->stop();
+}
+
+void TraceWriter::write(const TraceRun& run) {
+    TraceRecord record{.run = run};
+    record.run.type = TraceRecordType::RUN;
+    this->push(record);
+}
+
+void TraceWriter::write(const TraceStep& step) {
+    TraceRecord record{.step = step};
+    record.step.type = TraceRecordType::STEP;
+    this->push(record);
+}
+
+uint64_t TraceWriter::get_stall_count() const {
+    return this->stall_count;
+}
+
+void TraceWriter::close() {
+    this->stop();
+
+    if (this->write_failed) {
+        throw std::runtime_error("Could not write the trace file " + this->filename);
+    }
+}
+
+void TraceWriter::stop() {
+    if (not this->writer.joinable()) {
+        return;
+    }
+
+    this->stopping.store(true, std::memory_order_release);
+    this->writer.join();
+}
+
+void TraceWriter::push(const TraceRecord& record) {
+    if (this->buffer.push(record)) {
+        return;
+    }
+
+    this->stall_count++;
+
+    while (not this->buffer.push(record)) {
+        std::this_thread::yield();
+    }
+}
+
+void TraceWriter::run() {
+    std::vector<TraceRecord> batch(write_batch_size);
+
+    while (true) {
+        // Reading the flag before emptying the buffer makes sure every record queued before stopping is written
+        bool        stop = this->stopping.load(std::memory_order_acquire);
+        std::size_t count = this->buffer.pop(batch.data(), batch.size());
+
+        // A failed stream drops every later record, so the buffer is only emptied to keep the robots running
+        if (count > 0) {
+            if (not this->write_failed) {
+                this->file.write(
+                    reinterpret_cast<const char*>(batch.data()),
+                    static_cast<std::streamsize>(count * sizeof(TraceRecord))
+                );
+                this->write_failed = not this->file;
+            }
+
+            continue;
+        }
+
+        if (stop) {
+            break;
+        }
+
+        std::this_thread::sleep_for(write_period);
+    }
+
+    this->file.close();
+    this->write_failed = this->write_failed or not this->file;
+}
+
+TraceReader::TraceReader(const std::string& filename) :
+    filename(filename), file(filename), data(this->file.get_data()), offset(sizeof(TraceHeader)) {
+    TraceHeader header{};
+
+    if (this->data.size() < sizeof(TraceHeader)) {
+        throw std::runtime_error(filename + ": truncated trace header");
+    }
+
+    std::memcpy(&header, this->data.data(), sizeof(TraceHeader));
+
+    if (header.magic != trace_magic) {
+        throw std::runtime_error(filename + ": not a trace file");
+    }
+
+    if (header.version != trace_version) {
+        throw std::runtime_error(
+            filename + ": unsupported trace version " + std::to_string(header.version) + ", expected " +
+            std::to_string(trace_version)
+        );
+    }
+
+    if (header.record_size != sizeof(TraceRecord)) {
+        throw std::runtime_error(
+            filename + ": records of " + std::to_string(header.record_size) + " bytes, expected " +
+            std::to_string(sizeof(TraceRecord))
+        );
+    }
+}
+
+bool TraceReader::next(TraceRecord& record) {
+    if (this->offset >= this->data.size()) {
+        return false;
+    }
+
+    if (this->data.size() - this->offset < sizeof(TraceRecord)) {
+        throw std::runtime_error(this->filename + ": byte " + std::to_string(this->offset) + ": truncated record");
+    }
+
+    std::memcpy(&record, this->data.data() + this->offset, sizeof(TraceRecord));
+
+    if (record.run.type != TraceRecordType::RUN and record.run.type != TraceRecordType::STEP) {
+        throw std::runtime_error(
+            this->filename + ": byte " + std::to_string(this->offset) + ": unknown record type " +
+            std::to_string(record.run.type)
+        );
+    }
+
+    this->offset += sizeof(TraceRecord);
+
+    return true;
+}
+
+std::size_t TraceReader::get_offset() const {
+    return this->offset;
+}
+
+uint32_t trace_time(std::chrono::steady_clock::duration duration) {
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    return static_cast<uint32_t>(std::min<int64_t>(nanoseconds, std::numeric_limits<uint32_t>::max()));
+}
@@ -0,0 +1,134 @@
+#ifndef WALL_MAP_CPP
+#define WALL_MAP_CPP
+
+#include <bit>
+#include <cstring>
+
+#include "wall_map.hpp"
+
+template <uint8_t width, uint8_t height>
+WallMap<width, height>::WallMap(const GridSize<width, height>& size) :
+    GridSize<width, height>(size), east_walls(size), north_walls(size) {
+    this->reset();
+}
+
+template <uint8_t width, uint8_t height>
+void WallMap<width, height>::reset() {
+    this->east_walls.clear();
+    this->north_walls.clear();
+    this->add_borders();
+}
+
+template <uint8_t width, uint8_t height>
+void WallMap<width, height>::load(const MazeRecord& record) {
+    static_assert(std::endian::native == std::endian::little, "The record rows are copied as little endian words");
+
+    // Bits past the last column are dropped, as the rows of the record are padded to whole bytes
+    uint8_t  last_word = (this->get_width() - 1) / 64;
+    uint64_t last_word_mask = ~uint64_t{0} >> (63 - (this->get_width() - 1) % 64);
+
+    auto load_row = [&](Row& words, std::string_view bits) {
+        words = {};
+        std::memcpy(words.data(), bits.data(), bits.size());
+        words[last_word] &= last_word_mask;
+    };
+
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        load_row(this->east_walls.get_row(row), record.get_east_row(row));
+        load_row(this->north_walls.get_row(row), record.get_north_row(row));
+    }
+
+    this->add_borders();
+}
+
+template <uint8_t width, uint8_t height>
+void WallMap<width, height>::save(std::ostream& os) const {
+    std::size_t row_bytes = MazeRecord::get_row_bytes(this->get_width());
+
+    for (const auto* plane : {&this->east_walls, &this->north_walls}) {
+        for (uint8_t row = 0; row < this->get_height(); row++) {
+            os.write(
+                reinterpret_cast<const char*>(plane->get_row(row).data()), static_cast<std::streamsize>(row_bytes)
+            );
+        }
+    }
+}
+
+template <uint8_t width, uint8_t height>
+void WallMap<width, height>::add_borders() {
+    for (uint8_t row = 0; row < this->get_height(); row++) {
+        this->set_wall({{static_cast<uint8_t>(this->get_width() - 1), row}, Side::RIGHT}, true);
+    }
+
+    for (uint8_t col = 0; col < this->get_width(); col++) {
+        this->set_wall({{col, static_cast<uint8_t>(this->get_height() - 1)}, Side::UP}, true);
+    }
+}
+
+template <uint8_t width, uint8_t height>
+bool WallMap<width, height>::has_wall(const GridPose& pose) const {
+    GridPose edge = normalized(pose);
+
+    if (not this->is_inside(edge.position)) {
+        return true;
+    }
+
+    return (edge.orientation == Side::RIGHT ? this->east_walls : this->north_walls).contains(edge.position);
+}
+
+template <uint8_t width, uint8_t height>
+uint8_t WallMap<width, height>::get_walls(const GridPoint& position) const {
+    bool left_wall =
+        position.x == 0 or this->east_walls.contains({static_cast<uint8_t>(position.x - 1), position.y});
+    bool down_wall =
+        position.y == 0 or this->north_walls.contains({position.x, static_cast<uint8_t>(position.y - 1)});
+
+    return (this->east_walls.contains(position) << Side::RIGHT) | (this->north_walls.contains(position) << Side::UP) |
+           (left_wall << Side::LEFT) | (down_wall << Side::DOWN);
+}
+
+template <uint8_t width, uint8_t height>
+void WallMap<width, height>::set_wall(const GridPose& pose, bool wall) {
+    GridPose edge = normalized(pose);
+
+    if (not this->is_inside(edge.position)) {
+        return;
+    }
+
+    (edge.orientation == Side::RIGHT ? this->east_walls : this->north_walls)
+        .set(edge.position, wall or this->is_border(edge));
+}
+
+template <uint8_t width, uint8_t height>
+const WallMap<width, height>::Row& WallMap<width, height>::get_east_walls(uint8_t row) const {
+    return this->east_walls.get_row(row);
+}
+
+template <uint8_t width, uint8_t height>
+const WallMap<width, height>::Row& WallMap<width, height>::get_north_walls(uint8_t row) const {
+    return this->north_walls.get_row(row);
+}
+
+template <uint8_t width, uint8_t height>
+GridPose WallMap<width, height>::normalized(const GridPose& pose) {
+    // Computed in place, as this runs for every wall check of the flood fill
+    switch (pose.orientation) {
+        case Side::LEFT:
+            return {{static_cast<uint8_t>(pose.position.x - 1), pose.position.y}, Side::RIGHT};
+        case Side::DOWN:
+            return {{pose.position.x, static_cast<uint8_t>(pose.position.y - 1)}, Side::UP};
+        default:
+            return pose;
+    }
+}
+
+template <uint8_t width, uint8_t height>
+bool WallMap<width, height>::is_border(const GridPose& pose) const {
+    GridPose edge = normalized(pose);
+
+    return not this->is_inside(edge.position) or
+           (edge.orientation == Side::RIGHT and edge.position.x == this->get_width() - 1) or
+           (edge.orientation == Side::UP and edge.position.y == this->get_height() - 1);
+}
+
+#endif  // WALL_MAP_CPP
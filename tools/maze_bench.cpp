@@ -0,0 +1,1062 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "maze.hpp"
+#include "maze_generator.hpp"
+#include "maze_reader.hpp"
+#include "maze_record.hpp"
+#include "profiler.hpp"
+#include "sensor_model.hpp"
+#include "simulation.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+
+namespace {
+/**
+ * @brief Number of episodes of a maze run by a single task of the Monte Carlo evaluation
+ */
+constexpr uint32_t episode_chunk_size = 16;
+
+/**
+ * @brief Type to store the outcome of an episode of the Monte Carlo evaluation
+ */
+struct EpisodeOutcome {
+    uint32_t steps;
+    uint32_t collisions;
+    uint32_t slips;
+    bool     finished;
+    bool     stuck;
+};
+
+/**
+ * @brief Type to store a maze built once for the Monte Carlo evaluation, with an alternative for each size dispatched
+ *        by dispatch_size
+ */
+using BuiltMaze = std::variant<
+    std::monostate, std::unique_ptr<const Maze<5, 5>>, std::unique_ptr<const Maze<8, 8>>,
+    std::unique_ptr<const Maze<16, 16>>, std::unique_ptr<const Maze<32, 32>>, std::unique_ptr<const Maze<0, 0>>>;
+
+/**
+ * @brief Type to store the outcome of a maze of the corpus
+ */
+struct BenchResult {
+    std::string                        name;
+    std::string_view                   source;
+    std::size_t                        location{};
+    uint8_t                            width{};
+    uint8_t                            height{};
+    std::variant<MazeText, MazeRecord> maze;
+    BuiltMaze                          built_maze;
+    EpisodeResult                      episode;
+    EpisodeResult                      noiseless_episode;
+    std::vector<EpisodeOutcome>        outcomes;
+    double                             wall_time{};
+    double                             cpu_time{};
+    std::string                        error;
+};
+
+/**
+ * @brief Type to store the command line options
+ */
+struct Options {
+    std::vector<std::string> paths;
+    std::size_t              thread_count{};
+    uint32_t                 max_steps{100000};
+    bool                     csv{};
+    bool                     route_planner{true};
+    ExplorationStrategy      strategy{ExplorationStrategy::GOAL};
+    bool                     dynamic_size{};
+    bool                     check_costmap{};
+    std::string              trace_path;
+    std::string              profile_format;
+    SensorModel              sensor_model;
+    float                    slip{};
+    uint64_t                 seed{};
+    uint32_t                 episode_count{};
+    GridPoint                goal_position{};
+    uint8_t                  goal_width{};
+    uint8_t                  goal_height{};
+};
+
+/**
+ * @brief Type to store the episodes of a maze run by a task of the Monte Carlo evaluation, each task writing only to
+ *        its own outcomes and error so the workers share no mutable state
+ */
+struct EpisodeChunk {
+    BenchResult* result;
+    uint32_t     id;
+    uint32_t     first;
+    uint32_t     count;
+    std::string  error;
+};
+
+/**
+ * @brief Type to store the statistics of the episodes of a maze
+ */
+struct EpisodeStatistics {
+    std::size_t finished_count{};
+    uint32_t    median_steps{};
+    uint32_t    p90_steps{};
+    uint32_t    p99_steps{};
+    uint32_t    max_steps{};
+    uint32_t    worst_episode{};
+    uint64_t    collision_count{};
+    uint64_t    slip_count{};
+    std::size_t stuck_count{};
+};
+
+/**
+ * @brief Returns a pose as text
+ *
+ * @param pose The pose
+ * @return The position and orientation of the pose
+ */
+std::string pose_text(const GridPose& pose) {
+    constexpr std::array<char, 4> sides = {'R', 'U', 'L', 'D'};
+    return "(" + std::to_string(pose.position.x) + ", " + std::to_string(pose.position.y) + ", " +
+           sides.at(pose.orientation) + ")";
+}
+
+/**
+ * @brief Returns where a maze of the corpus is, as its file and its first line or its byte offset
+ *
+ * @param result The maze of the corpus
+ * @return The location of the maze
+ */
+std::string location_text(const BenchResult& result) {
+    if (std::holds_alternative<MazeText>(result.maze)) {
+        return std::string(result.source) + ":" + std::to_string(result.location);
+    }
+
+    return std::string(result.source) + " byte " + std::to_string(result.location);
+}
+
+/**
+ * @brief Checks whether the robot runs with noisy sensors or slipping wheels
+ *
+ * @param options The command line options
+ * @return True if the runs are noisy, false otherwise
+ */
+bool is_noisy(const Options& options) {
+    return not options.sensor_model.is_perfect() or options.slip > 0.0F;
+}
+
+/**
+ * @brief Returns the seed of an episode, so that it does not depend on the worker running it
+ *
+ * @param options The command line options
+ * @param id The index of the maze in the corpus
+ * @param episode The index of the episode, zero for single runs
+ * @return The seed of the episode
+ */
+uint64_t get_episode_seed(const Options& options, uint32_t id, uint32_t episode) {
+    return MazeGenerator::derive_seed(MazeGenerator::derive_seed(options.seed, id), episode);
+}
+
+/**
+ * @brief Returns the CPU time used by the calling thread
+ *
+ * @return The CPU time in seconds
+ */
+double thread_cpu_time() {
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief Returns the simulation of the calling thread for the size of a maze, set up with the command line options
+ *
+ * @param maze The maze to be run
+ * @param options The command line options
+ * @return The simulation, without noise
+ */
+template <uint8_t width, uint8_t height>
+Simulation<width, height>& get_simulation(const Maze<width, height>& maze, const Options& options) {
+    // Each worker keeps one simulation per size, resized only when the size of the mazes changes
+    thread_local std::optional<Simulation<width, height>> simulation;
+
+    if (not simulation or simulation->get_micras().get_known_maze().get_width() != maze.get_width() or
+        simulation->get_micras().get_known_maze().get_height() != maze.get_height()) {
+        simulation.emplace(GridPose{{0, 0}, Side::UP}, maze);
+    }
+
+    if (options.goal_width > 0) {
+        simulation->get_micras().set_goal(options.goal_position, options.goal_width, options.goal_height);
+    }
+
+    simulation->set_route_planner(options.route_planner);
+    simulation->get_micras().set_exploration_strategy(options.strategy);
+    simulation->set_sensor_model(SensorModel{});
+    simulation->set_slip_probability(0.0F);
+
+    return *simulation;
+}
+
+/**
+ * @brief Checks that a repaired costmap gives every cell the cost, distance and origin of the recomputed one
+ *
+ * @param name The name of the costmap, for the error
+ * @param repaired The costmap repaired after each wall change
+ * @param recomputed The costmap recomputed after each wall change
+ * @param step The step of the run, for the error
+ */
+template <uint8_t width, uint8_t height>
+void check_costmap(
+    std::string_view name, const Costmap<width, height>& repaired, const Costmap<width, height>& recomputed,
+    uint32_t step
+) {
+    for (uint8_t y = 0; y < recomputed.get_height(); y++) {
+        for (uint8_t x = 0; x < recomputed.get_width(); x++) {
+            uint16_t distance = recomputed.get_distance({x, y});
+
+            // The origins of the seeds and of the unreachable cells are left over from previous flood fills
+            bool reached = distance != 0 and distance != 0xFFFF;
+
+            if (repaired.get_cost({x, y}) != recomputed.get_cost({x, y}) or
+                repaired.get_distance({x, y}) != distance or
+                (reached and repaired.get_origin({x, y}) != recomputed.get_origin({x, y}))) {
+                throw std::runtime_error(
+                    "The repaired " + std::string(name) + " costmap differs from the recomputed one at step " +
+                    std::to_string(step) + ", cell (" + std::to_string(x) + ", " + std::to_string(y) + ")"
+                );
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs a maze with two robots, one repairing its costmaps and the other recomputing them, checking after every
+ *        step that they are in the same pose and agree on every cell of their costmaps
+ *
+ * @param maze The maze to be run
+ * @param options The command line options
+ * @param id The index of the maze in the corpus, seeding the noise of the readings
+ * @param episode The index of the episode, seeding the noise of the readings
+ */
+template <uint8_t width, uint8_t height>
+void check_costmaps(const Maze<width, height>& maze, const Options& options, uint32_t id, uint32_t episode) {
+    constexpr GridPose          start{{0, 0}, Side::UP};
+    Micras<width, height>       incremental(start, maze);
+    Micras<width, height>       full(start, maze);
+    RoutePlanner<width, height> incremental_planner({}, maze);
+    RoutePlanner<width, height> full_planner({}, maze);
+    std::mt19937_64             random(get_episode_seed(options, id, episode));
+
+    incremental.set_route_planner(options.route_planner ? &incremental_planner : nullptr);
+    full.set_route_planner(options.route_planner ? &full_planner : nullptr);
+
+    for (Micras<width, height>* micras : {&incremental, &full}) {
+        if (options.goal_width > 0) {
+            micras->set_goal(options.goal_position, options.goal_width, options.goal_height);
+        }
+
+        micras->set_exploration_strategy(options.strategy);
+        micras->set_sensor_model(options.sensor_model);
+        micras->reset(start);
+    }
+
+    full.set_incremental_costmap(false);
+
+    const KnownMaze<width, height>& incremental_maze = incremental.get_known_maze();
+    const KnownMaze<width, height>& full_maze = full.get_known_maze();
+
+    for (uint32_t step = 1; step <= options.max_steps; step++) {
+        GridPoint   position = incremental.get_pose().position;
+        Information information = maze.get_information(incremental.get_pose());
+        bool        blocked = information.front == Information::WALL;
+
+        // Both robots read the same noisy values, so any difference comes from their costmaps
+        if (not options.sensor_model.is_perfect()) {
+            information = options.sensor_model.apply(information, random);
+        }
+
+        incremental.step(information);
+        full.step(information);
+
+        if (blocked and incremental.get_pose().position != position) {
+            incremental.bump();
+            full.bump();
+        }
+
+        if (not(incremental.get_pose() == full.get_pose())) {
+            throw std::runtime_error(
+                "The repaired and recomputed costmaps lead to different poses at step " + std::to_string(step)
+            );
+        }
+
+        check_costmap("goal", incremental_maze.get_costmap(), full_maze.get_costmap(), step);
+        check_costmap("start", incremental_maze.get_start_costmap(), full_maze.get_start_costmap(), step);
+        check_costmap("explored", incremental_maze.get_explored_costmap(), full_maze.get_explored_costmap(), step);
+
+        if (not incremental_maze.is_exploring() and
+            (blocked or incremental_maze.get_goal().contains(incremental.get_pose().position))) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Runs the whole cycle in a maze, reusing the simulation of the calling thread
+ *
+ * @param result The result to be filled
+ * @param options The command line options
+ * @param trace The trace of the calling thread, null if the runs are not traced
+ * @param id The index of the maze in the corpus, written in the trace
+ */
+template <uint8_t width, uint8_t height>
+void run_maze(BenchResult& result, const Options& options, TraceWriter* trace, uint32_t id) {
+    Maze<width, height> maze = std::visit([](const auto& entry) { return Maze<width, height>(entry); }, result.maze);
+
+    if (options.check_costmap) {
+        check_costmaps(maze, options, id, 0);
+    }
+
+    Simulation<width, height>& simulation = get_simulation(maze, options);
+
+    // Noisy runs are compared with a run of perfect sensors and wheels, which is not traced
+    if (is_noisy(options)) {
+        simulation.get_micras().set_trace(nullptr);
+        result.noiseless_episode = simulation.run(maze, options.max_steps);
+    }
+
+    simulation.get_micras().set_trace(trace, id);
+    simulation.set_sensor_model(options.sensor_model);
+    simulation.set_slip_probability(options.slip);
+    simulation.set_seed(get_episode_seed(options, id, 0));
+    result.episode = simulation.run(maze, options.max_steps);
+
+    if (not is_noisy(options)) {
+        result.noiseless_episode = result.episode;
+    }
+}
+
+/**
+ * @brief Runs the episodes of a chunk of the Monte Carlo evaluation, reusing the simulation of the calling thread
+ *
+ * @param chunk The chunk to be run, whose outcomes are filled
+ * @param options The command line options
+ */
+template <uint8_t width, uint8_t height>
+void run_episodes(EpisodeChunk& chunk, const Options& options) {
+    BenchResult& result = *chunk.result;
+
+    // The maze was built by build_maze with the same options, so it has the size dispatched here
+    const auto& maze = *std::get<std::unique_ptr<const Maze<width, height>>>(result.built_maze);
+
+    Simulation<width, height>& simulation = get_simulation(maze, options);
+
+    simulation.get_micras().set_trace(nullptr);
+    simulation.set_sensor_model(options.sensor_model);
+    simulation.set_slip_probability(options.slip);
+
+    for (uint32_t episode = chunk.first; episode < chunk.first + chunk.count; episode++) {
+        if (options.check_costmap) {
+            check_costmaps(maze, options, chunk.id, episode);
+        }
+
+        simulation.set_seed(get_episode_seed(options, chunk.id, episode));
+        EpisodeResult outcome = simulation.run(maze, options.max_steps);
+        result.outcomes[episode] = {
+            outcome.steps, outcome.collisions, outcome.slips, outcome.finished, outcome.stuck
+        };
+    }
+}
+
+/**
+ * @brief Calls a function with the size of a maze of the corpus, dispatching to the compiled sizes and to the runtime
+ *        size otherwise
+ *
+ * @param result The maze of the corpus
+ * @param options The command line options
+ * @param function The function, with the width and height as template parameters
+ */
+template <typename Function>
+void dispatch_size(const BenchResult& result, const Options& options, const Function& function) {
+    uint8_t width = result.width;
+    uint8_t height = result.height;
+
+    if (options.dynamic_size) {
+        function.template operator()<0, 0>();
+    } else if (width == 5 and height == 5) {
+        function.template operator()<5, 5>();
+    } else if (width == 8 and height == 8) {
+        function.template operator()<8, 8>();
+    } else if (width == 16 and height == 16) {
+        function.template operator()<16, 16>();
+    } else if (width == 32 and height == 32) {
+        function.template operator()<32, 32>();
+    } else {
+        function.template operator()<0, 0>();
+    }
+}
+
+/**
+ * @brief Runs a maze of the corpus
+ *
+ * @param result The result to be filled
+ * @param options The command line options
+ * @param trace The trace of the calling thread, null if the runs are not traced
+ * @param id The index of the maze in the corpus, written in the trace
+ */
+void run_entry(BenchResult& result, const Options& options, TraceWriter* trace, uint32_t id) {
+    auto   wall_start = std::chrono::steady_clock::now();
+    double cpu_start = thread_cpu_time();
+
+    try {
+        dispatch_size(result, options, [&]<uint8_t width, uint8_t height>() {
+            run_maze<width, height>(result, options, trace, id);
+        });
+    } catch (const std::exception& exception) {
+        result.error = exception.what();
+    }
+
+    result.cpu_time = thread_cpu_time() - cpu_start;
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+}
+
+/**
+ * @brief Builds the maze of an entry of the corpus, to be shared read only by the chunks of its episodes
+ *
+ * @param result The entry of the corpus, whose error is filled if the maze is invalid
+ * @param options The command line options
+ */
+void build_maze(BenchResult& result, const Options& options) {
+    try {
+        dispatch_size(result, options, [&]<uint8_t width, uint8_t height>() {
+            result.built_maze = std::visit(
+                [](const auto& entry) { return std::make_unique<const Maze<width, height>>(entry); }, result.maze
+            );
+        });
+    } catch (const std::exception& exception) {
+        result.error = exception.what();
+    }
+}
+
+/**
+ * @brief Runs a chunk of the Monte Carlo evaluation
+ *
+ * @param chunk The chunk to be run
+ * @param options The command line options
+ */
+void run_chunk(EpisodeChunk& chunk, const Options& options) {
+    try {
+        dispatch_size(*chunk.result, options, [&]<uint8_t width, uint8_t height>() {
+            run_episodes<width, height>(chunk, options);
+        });
+    } catch (const std::exception& exception) {
+        chunk.error = exception.what();
+    }
+}
+
+/**
+ * @brief Returns a percentile of sorted values, by the nearest rank
+ *
+ * @param values The sorted values
+ * @param fraction The fraction of the values at or below the percentile
+ * @return The percentile, zero if there are no values
+ */
+uint32_t get_percentile(const std::vector<uint32_t>& values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+
+    auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+    return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+}
+
+/**
+ * @brief Summarizes the episodes of a maze
+ *
+ * @param outcomes The outcomes of the episodes
+ * @param steps Buffer receiving the sorted steps of the finished episodes
+ * @return The statistics of the episodes, with the steps of the finished ones
+ */
+EpisodeStatistics summarize(const std::vector<EpisodeOutcome>& outcomes, std::vector<uint32_t>& steps) {
+    EpisodeStatistics statistics;
+    bool              worst_finished = true;
+
+    steps.clear();
+
+    for (uint32_t episode = 0; episode < outcomes.size(); episode++) {
+        const EpisodeOutcome& outcome = outcomes[episode];
+
+        statistics.collision_count += outcome.collisions;
+        statistics.slip_count += outcome.slips;
+        statistics.stuck_count += outcome.stuck ? 1 : 0;
+
+        // The worst episode is the first one that did not finish, or else the longest one
+        if (outcome.finished) {
+            steps.push_back(outcome.steps);
+
+            if (worst_finished and outcome.steps > statistics.max_steps) {
+                statistics.worst_episode = episode;
+            }
+
+            statistics.max_steps = std::max(statistics.max_steps, outcome.steps);
+        } else if (worst_finished) {
+            statistics.worst_episode = episode;
+            worst_finished = false;
+        }
+    }
+
+    std::sort(steps.begin(), steps.end());
+
+    statistics.finished_count = steps.size();
+    statistics.median_steps = get_percentile(steps, 0.5);
+    statistics.p90_steps = get_percentile(steps, 0.9);
+    statistics.p99_steps = get_percentile(steps, 0.99);
+
+    return statistics;
+}
+
+/**
+ * @brief Runs the Monte Carlo evaluation, with many independently seeded episodes per maze, and prints its report
+ *
+ * @param results The corpus
+ * @param options The command line options
+ * @return The exit code of the program
+ */
+int run_monte_carlo(std::vector<BenchResult>& results, const Options& options) {
+    std::vector<EpisodeChunk> chunks;
+    auto                      wall_start = std::chrono::steady_clock::now();
+    std::size_t               thread_count{};
+
+    {
+        ThreadPool pool(options.thread_count);
+        thread_count = pool.get_thread_count();
+
+        // Each maze is built once, then every worker running its episodes reads the same one
+        for (auto& result : results) {
+            pool.submit([&result, &options]() { build_maze(result, options); });
+        }
+
+        pool.wait();
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            results[i].outcomes.resize(options.episode_count);
+
+            if (std::holds_alternative<std::monostate>(results[i].built_maze)) {
+                continue;
+            }
+
+            for (uint32_t first = 0; first < options.episode_count; first += episode_chunk_size) {
+                uint32_t count = std::min(episode_chunk_size, options.episode_count - first);
+                chunks.push_back({&results[i], static_cast<uint32_t>(i), first, count, {}});
+            }
+        }
+
+        for (auto& chunk : chunks) {
+            pool.submit([&chunk, &options]() { run_chunk(chunk, options); });
+        }
+
+        pool.wait();
+    }
+
+    double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    for (const auto& chunk : chunks) {
+        if (not chunk.error.empty() and chunk.result->error.empty()) {
+            chunk.result->error = chunk.error;
+        }
+    }
+
+    if (options.csv) {
+        std::cout << "file,line,width,height,episodes,finished,median_steps,p90_steps,p99_steps,max_steps,"
+                     "worst_episode,collisions,slips,stuck,error\n";
+    } else {
+        std::cout << std::left << std::setw(40) << "file" << std::right << std::setw(8) << "size" << std::setw(10)
+                  << "success" << std::setw(8) << "median" << std::setw(8) << "p90" << std::setw(8) << "p99"
+                  << std::setw(8) << "max" << std::setw(8) << "worst" << std::setw(12) << "collisions" << std::setw(8)
+                  << "slips" << '\n';
+    }
+
+    std::vector<uint32_t>          steps;
+    std::vector<uint32_t>          all_steps;
+    std::vector<EpisodeStatistics> statistics(results.size());
+    uint64_t                       collision_count = 0;
+    uint64_t                       slip_count = 0;
+    std::size_t                    stuck_count = 0;
+    std::size_t                    error_count = 0;
+    double                         episode_count = std::max<double>(options.episode_count, 1);
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        statistics[i] = summarize(result.outcomes, steps);
+
+        const EpisodeStatistics& maze = statistics[i];
+        all_steps.insert(all_steps.end(), steps.begin(), steps.end());
+        collision_count += maze.collision_count;
+        slip_count += maze.slip_count;
+        stuck_count += maze.stuck_count;
+        error_count += result.error.empty() ? 0 : 1;
+
+        if (options.csv) {
+            std::cout << result.source << ',' << result.location << ',' << +result.width << ',' << +result.height
+                      << ',' << options.episode_count << ',' << maze.finished_count << ',' << maze.median_steps << ','
+                      << maze.p90_steps << ',' << maze.p99_steps << ',' << maze.max_steps << ','
+                      << maze.worst_episode << ',' << maze.collision_count << ',' << maze.slip_count << ','
+                      << maze.stuck_count << ',' << result.error << '\n';
+            continue;
+        }
+
+        std::string size = std::to_string(result.width) + "x" + std::to_string(result.height);
+
+        std::cout << std::left << std::setw(40) << result.name << std::right << std::setw(8) << size << std::setw(9)
+                  << std::fixed << std::setprecision(1)
+                  << 100.0 * static_cast<double>(maze.finished_count) / episode_count << '%' << std::setw(8)
+                  << maze.median_steps << std::setw(8) << maze.p90_steps << std::setw(8) << maze.p99_steps
+                  << std::setw(8) << maze.max_steps << std::setw(8) << maze.worst_episode << std::setw(12)
+                  << std::setprecision(2) << static_cast<double>(maze.collision_count) / episode_count
+                  << std::setw(8) << static_cast<double>(maze.slip_count) / episode_count << "  " << result.error
+                  << '\n';
+    }
+
+    std::sort(all_steps.begin(), all_steps.end());
+
+    double total_count = static_cast<double>(results.size()) * options.episode_count;
+
+    std::cerr << results.size() << " mazes x " << options.episode_count << " episodes, " << all_steps.size()
+              << " finished (" << std::fixed << std::setprecision(2)
+              << 100.0 * static_cast<double>(all_steps.size()) / std::max(total_count, 1.0) << "%), steps median "
+              << get_percentile(all_steps, 0.5) << " p90 " << get_percentile(all_steps, 0.9) << " p99 "
+              << get_percentile(all_steps, 0.99) << " max " << (all_steps.empty() ? 0 : all_steps.back()) << ", "
+              << collision_count << " collisions, " << slip_count << " slips, " << stuck_count << " stuck, "
+              << thread_count << " threads, "
+              << std::setprecision(3) << wall_time << " s wall, " << std::setprecision(1) << total_count / wall_time
+              << " episodes/s\n";
+
+    // The mazes failing most often come first, then the ones with the longest tails
+    std::vector<std::size_t> order(results.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&statistics](std::size_t a, std::size_t b) {
+        if (statistics[a].finished_count != statistics[b].finished_count) {
+            return statistics[a].finished_count < statistics[b].finished_count;
+        }
+
+        return statistics[a].p99_steps > statistics[b].p99_steps;
+    });
+
+    for (std::size_t i = 0; i < std::min<std::size_t>(order.size(), 5); i++) {
+        const EpisodeStatistics& maze = statistics[order[i]];
+
+        std::cerr << "worst " << i + 1 << ": " << results[order[i]].name << ", " << maze.finished_count << " of "
+                  << options.episode_count << " finished, " << maze.stuck_count << " stuck, p99 " << maze.p99_steps
+                  << " steps, episode " << maze.worst_episode << '\n';
+    }
+
+    // Stuck robots point to a bug of the solver rather than a hard maze, so each maze is located with an episode
+    if (stuck_count > 0) {
+        std::cerr << stuck_count << " episodes stuck, the robot keeping its pose for "
+                  << Simulation<0, 0>::stuck_steps << " steps:\n";
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const auto& outcomes = results[i].outcomes;
+            auto        stuck = std::find_if(outcomes.begin(), outcomes.end(), [](const EpisodeOutcome& outcome) {
+                return outcome.stuck;
+            });
+
+            if (stuck != outcomes.end()) {
+                std::cerr << "  " << results[i].name << " (" << location_text(results[i]) << "), "
+                          << statistics[i].stuck_count << " episodes, the first being episode "
+                          << std::distance(outcomes.begin(), stuck) << '\n';
+            }
+        }
+    }
+
+    if (options.profile_format == "json") {
+        Profiler::collect().write_json(std::cerr);
+    } else if (options.profile_format == "table") {
+        Profiler::collect().write_table(std::cerr);
+    }
+
+    // The stuck detector only cuts the run short, a robot keeping its pose is still a bug of the solver
+    if (stuck_count > 0) {
+        return 3;
+    }
+
+    return error_count == 0 ? 0 : 2;
+}
+
+/**
+ * @brief Reads every maze of a reader into the corpus
+ *
+ * @tparam Entry The type of the mazes read, a drawing or a binary record
+ * @param reader The reader of the mazes
+ * @param results The corpus, with one result per maze
+ */
+template <typename Entry, typename Reader>
+void read_corpus(Reader& reader, std::vector<BenchResult>& results) {
+    Entry entry{};
+
+    while (reader.next(entry)) {
+        std::string name = std::filesystem::path(entry.source).filename().string();
+
+        if (entry.index > 0) {
+            name += "#" + std::to_string(entry.index);
+        }
+
+        // Drawings are located by their first line and binary records by their offset in bytes
+        std::size_t location = 0;
+
+        if constexpr (std::is_same_v<Entry, MazeText>) {
+            location = entry.line;
+        } else {
+            location = entry.offset;
+        }
+
+        BenchResult& result = results.emplace_back();
+        result.name = name;
+        result.source = entry.source;
+        result.location = location;
+        result.width = entry.width;
+        result.height = entry.height;
+        result.maze = entry;
+    }
+}
+
+/**
+ * @brief Parses the goal rectangle given in the command line
+ *
+ * @param text The column and row of the lower left cell, the width and the height, separated by commas
+ * @param options The options receiving the goal
+ */
+void parse_goal(const std::string& text, Options& options) {
+    std::array<uint8_t, 4> values{};
+    std::size_t            begin = 0;
+
+    for (std::size_t i = 0; i < values.size(); i++) {
+        std::size_t end = i + 1 < values.size() ? text.find(',', begin) : text.size();
+
+        if (end == std::string::npos or end == begin) {
+            throw std::runtime_error("Expected the goal as COLUMN,ROW,WIDTH,HEIGHT, found " + text);
+        }
+
+        unsigned long value = std::stoul(text.substr(begin, end - begin));
+
+        if (value > 0xFF) {
+            throw std::runtime_error("The goal " + text + " does not fit in the largest maze");
+        }
+
+        values[i] = static_cast<uint8_t>(value);
+        begin = end + 1;
+    }
+
+    if (values[2] == 0 or values[3] == 0) {
+        throw std::runtime_error("The goal " + text + " has no cells");
+    }
+
+    options.goal_position = {values[0], values[1]};
+    options.goal_width = values[2];
+    options.goal_height = values[3];
+}
+
+/**
+ * @brief Parses the command line options
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The parsed options
+ */
+Options parse_options(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--threads" and i + 1 < argc) {
+            options.thread_count = std::stoul(argv[++i]);
+        } else if (argument == "--max-steps" and i + 1 < argc) {
+            options.max_steps = std::stoul(argv[++i]);
+        } else if (argument == "--csv") {
+            options.csv = true;
+        } else if (argument == "--flood-fill") {
+            options.route_planner = false;
+        } else if (argument == "--strategy" and i + 1 < argc) {
+            std::string strategy = argv[++i];
+
+            if (strategy == "goal") {
+                options.strategy = ExplorationStrategy::GOAL;
+            } else if (strategy == "optimal") {
+                options.strategy = ExplorationStrategy::PROVE_OPTIMAL;
+            } else if (strategy == "frontier") {
+                options.strategy = ExplorationStrategy::FRONTIER;
+            } else {
+                throw std::runtime_error("Unknown strategy " + strategy + ", expected goal, optimal or frontier");
+            }
+        } else if (argument == "--trace" and i + 1 < argc) {
+            options.trace_path = argv[++i];
+        } else if (argument == "--profile" and i + 1 < argc) {
+            std::string format = argv[++i];
+
+            if (format != "table" and format != "json") {
+                throw std::runtime_error("Unknown profile format " + format + ", expected table or json");
+            }
+
+            options.profile_format = format;
+
+            if (not Profiler::enabled) {
+                throw std::runtime_error("The profiler was not compiled in, configure the project with -DPROFILING=ON");
+            }
+        } else if (argument == "--noise" and i + 1 < argc) {
+            options.sensor_model = SensorModel::parse(argv[++i]);
+        } else if (argument == "--slip" and i + 1 < argc) {
+            options.slip = std::stof(argv[++i]);
+
+            if (options.slip < 0.0F or options.slip >= 1.0F) {
+                throw std::runtime_error("The slip probability goes from 0 to 1, excluded");
+            }
+        } else if (argument == "--seed" and i + 1 < argc) {
+            options.seed = std::stoull(argv[++i]);
+        } else if (argument == "--episodes" and i + 1 < argc) {
+            options.episode_count = std::stoul(argv[++i]);
+        } else if (argument == "--goal" and i + 1 < argc) {
+            parse_goal(argv[++i], options);
+        } else if (argument == "--dynamic") {
+            options.dynamic_size = true;
+        } else if (argument == "--check-costmap") {
+            options.check_costmap = true;
+        } else if (argument.starts_with("--")) {
+            throw std::runtime_error("Unknown option " + argument);
+        } else {
+            options.paths.push_back(argument);
+        }
+    }
+
+    if (options.paths.empty()) {
+        throw std::runtime_error(
+            "Usage: maze_bench [--threads N] [--max-steps N] [--csv] [--flood-fill] [--strategy goal|optimal|frontier] "
+            "[--goal COL,ROW,W,H] [--noise FP,FN[,RANGE]] [--slip P] [--seed N] [--episodes N] [--dynamic] "
+            "[--check-costmap] [--trace DIR] [--profile table|json] <maze files or directories>"
+        );
+    }
+
+    // Thousands of episodes per maze would make traces too large to be useful
+    if (options.episode_count > 0 and not options.trace_path.empty()) {
+        throw std::runtime_error("Traces are only written for single runs, not with --episodes");
+    }
+
+    return options;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    std::vector<BenchResult>     results;
+    std::deque<MazeReader>       text_readers;
+    std::deque<MazeRecordReader> record_readers;
+    auto                         read_start = std::chrono::steady_clock::now();
+
+    try {
+        for (const auto& path : options.paths) {
+            if (MazeRecordReader::is_binary(path)) {
+                read_corpus<MazeRecord>(record_readers.emplace_back(path), results);
+            } else {
+                read_corpus<MazeText>(text_readers.emplace_back(path), results);
+            }
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    double read_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - read_start).count();
+
+    if (options.episode_count > 0) {
+        try {
+            return run_monte_carlo(results, options);
+        } catch (const std::exception& exception) {
+            std::cerr << exception.what() << '\n';
+            return 1;
+        }
+    }
+
+    auto        wall_start = std::chrono::steady_clock::now();
+    std::size_t thread_count{};
+    uint64_t    stall_count = 0;
+
+    try {
+        ThreadPool pool(options.thread_count);
+        thread_count = pool.get_thread_count();
+
+        // Each worker writes its own trace, with the runs identified by the index of their maze
+        std::vector<std::unique_ptr<TraceWriter>> traces(thread_count);
+
+        if (not options.trace_path.empty()) {
+            std::filesystem::create_directories(options.trace_path);
+
+            for (std::size_t i = 0; i < thread_count; i++) {
+                std::string filename = "worker_" + std::to_string(i) + ".mzt";
+                traces[i] = std::make_unique<TraceWriter>(std::filesystem::path(options.trace_path) / filename);
+            }
+        }
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            pool.submit([&result = results[i], &options, &pool, &traces, i]() {
+                run_entry(result, options, traces[pool.get_worker_index()].get(), static_cast<uint32_t>(i));
+            });
+        }
+
+        pool.wait();
+
+        // Closing reports the records that could not be written, such as on a full disk
+        for (const auto& trace : traces) {
+            if (trace) {
+                trace->close();
+                stall_count += trace->get_stall_count();
+            }
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    if (options.csv) {
+        std::cout << "file,line,width,height,finished,steps,exploration_steps,map_updates,motions,fast_run_steps,"
+                     "route_cost,route_time,route_proven,collisions,route_blocked,stuck,noiseless_steps,wall_time,"
+                     "cpu_time,error\n";
+    } else {
+        std::cout << std::left << std::setw(40) << "file" << std::right << std::setw(8) << "size" << std::setw(8)
+                  << "steps" << std::setw(8) << "explore" << std::setw(8) << "fast" << std::setw(6) << "cost"
+                  << std::setw(10) << "time [s]" << std::setw(8) << "proven" << std::setw(12) << "wall [ms]"
+                  << std::setw(12) << "cpu [ms]" << '\n';
+    }
+
+    std::size_t finished_count = 0;
+    std::size_t proven_count = 0;
+    double      cpu_time = 0;
+    uint64_t    step_count = 0;
+    uint64_t    exploration_step_count = 0;
+    uint64_t    map_update_count = 0;
+    uint64_t    motion_count = 0;
+    uint64_t    noiseless_step_count = 0;
+    uint64_t    collision_count = 0;
+    uint64_t    slip_count = 0;
+    std::size_t blocked_count = 0;
+    std::size_t longer_count = 0;
+    std::size_t stuck_count = 0;
+
+    for (const auto& result : results) {
+        const EpisodeResult& episode = result.episode;
+
+        finished_count += episode.finished ? 1 : 0;
+        proven_count += episode.route_proven ? 1 : 0;
+        cpu_time += result.cpu_time;
+        step_count += episode.steps;
+        exploration_step_count += episode.exploration_steps;
+        map_update_count += episode.map_updates;
+        motion_count += episode.motions;
+        noiseless_step_count += result.noiseless_episode.steps;
+        collision_count += episode.collisions;
+        slip_count += episode.slips;
+        blocked_count += episode.route_blocked ? 1 : 0;
+        stuck_count += episode.stuck ? 1 : 0;
+
+        if (episode.finished and result.noiseless_episode.finished and
+            episode.route_cost > result.noiseless_episode.route_cost) {
+            longer_count++;
+        }
+
+        if (options.csv) {
+            std::cout << result.source << ',' << result.location << ',' << +result.width << ',' << +result.height
+                      << ',' << episode.finished << ',' << episode.steps << ',' << episode.exploration_steps << ','
+                      << episode.map_updates << ',' << episode.motions << ',' << episode.fast_run_steps << ','
+                      << episode.route_cost << ',' << episode.route_time << ',' << episode.route_proven << ','
+                      << episode.collisions << ',' << episode.route_blocked << ',' << episode.stuck << ','
+                      << result.noiseless_episode.steps << ',' << result.wall_time << ',' << result.cpu_time << ','
+                      << result.error << '\n';
+            continue;
+        }
+
+        std::string size = std::to_string(result.width) + "x" + std::to_string(result.height);
+
+        std::cout << std::left << std::setw(40) << result.name
+                  << std::right << std::setw(8) << size << std::setw(8) << episode.steps << std::setw(8)
+                  << episode.exploration_steps << std::setw(8) << episode.fast_run_steps << std::setw(6)
+                  << episode.route_cost << std::setw(10) << std::fixed << std::setprecision(2) << episode.route_time
+                  << std::setw(8) << (episode.route_proven ? "yes" : "no") << std::setw(12) << std::setprecision(3)
+                  << result.wall_time * 1e3 << std::setw(12) << result.cpu_time * 1e3
+                  << (episode.finished ? "" : "  unfinished ") << (episode.route_blocked ? "  blocked " : "")
+                  << (episode.stuck ? "  stuck at " + pose_text(episode.stuck_pose) + " " : "") << result.error
+                  << '\n';
+    }
+
+    std::cerr << results.size() << " mazes read in " << std::fixed << std::setprecision(3) << read_time << " s, "
+              << finished_count << " finished, " << proven_count << " proven, " << step_count << " steps, "
+              << thread_count << " threads, " << wall_time << " s wall, " << cpu_time << " s cpu, "
+              << std::setprecision(1) << static_cast<double>(results.size()) / wall_time << " mazes/s\n";
+    std::cerr << map_update_count << " map updates in " << exploration_step_count
+              << " exploration steps, the others driving straight through known cells\n";
+    std::cerr << motion_count << " motion primitives in " << step_count
+              << " steps, each turning in place and then driving straight\n";
+
+    // Stuck robots point to a bug of the solver rather than a hard maze, so each one is located for a replay
+    if (stuck_count > 0) {
+        std::cerr << stuck_count << " runs stuck, the robot keeping its pose for " << Simulation<0, 0>::stuck_steps
+                  << " steps:\n";
+
+        for (const auto& result : results) {
+            if (result.episode.stuck) {
+                std::cerr << "  " << result.name << " (" << location_text(result) << ") stuck at "
+                          << pose_text(result.episode.stuck_pose) << " after " << result.episode.steps
+                          << " steps\n";
+            }
+        }
+    }
+
+    if (is_noisy(options)) {
+        int64_t extra_steps = static_cast<int64_t>(step_count) - static_cast<int64_t>(noiseless_step_count);
+
+        std::cerr << "noise cost " << extra_steps << " extra steps (" << std::showpos
+                  << 100.0 * static_cast<double>(extra_steps) / std::max<double>(noiseless_step_count, 1) << "%"
+                  << std::noshowpos << "), " << collision_count << " collisions, " << slip_count << " slips, "
+                  << blocked_count << " routes blocked by a wall, " << longer_count
+                  << " routes longer than without noise\n";
+    }
+
+    if (not options.trace_path.empty()) {
+        std::cerr << thread_count << " traces written to " << options.trace_path << ", " << stall_count
+                  << " stalls\n";
+    }
+
+    // The workers already exited, so the report holds the metrics of every run
+    if (options.profile_format == "json") {
+        Profiler::collect().write_json(std::cerr);
+    } else if (options.profile_format == "table") {
+        Profiler::collect().write_table(std::cerr);
+    }
+
+    // The stuck detector only cuts the run short, a robot keeping its pose is still a bug of the solver
+    if (stuck_count > 0) {
+        return 3;
+    }
+
+    return finished_count == results.size() ? 0 : 2;
+}
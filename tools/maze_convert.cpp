@@ -0,0 +1,119 @@
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "maze.hpp"
+#include "maze_reader.hpp"
+#include "maze_record.hpp"
+
+namespace {
+/**
+ * @brief Type to store the command line options
+ */
+struct Options {
+    std::vector<std::string> inputs;
+    std::string              output;
+    bool                     text{};
+};
+
+/**
+ * @brief Writes every maze of a reader in the output format
+ *
+ * @tparam Entry The type of the mazes read, a drawing or a binary record
+ * @param reader The reader of the mazes
+ * @param output The output stream
+ * @param text Whether to write drawings instead of binary records
+ * @param count The number of mazes already written, updated with the new ones
+ */
+template <typename Entry, typename Reader>
+void convert(Reader& reader, std::ostream& output, bool text, std::size_t& count) {
+    Entry entry{};
+
+    while (reader.next(entry)) {
+        Maze<0, 0> maze(entry);
+
+        if (text) {
+            // Drawings are separated by blank lines
+            if (count > 0) {
+                output << '\n';
+            }
+
+            maze.save_text(output);
+        } else {
+            maze.save(output);
+        }
+
+        count++;
+    }
+}
+
+/**
+ * @brief Parses the command line options
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The parsed options
+ */
+Options parse_options(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--text") {
+            options.text = true;
+        } else if (argument.starts_with("--")) {
+            throw std::runtime_error("Unknown option " + argument);
+        } else {
+            options.inputs.push_back(argument);
+        }
+    }
+
+    if (options.inputs.size() < 2) {
+        throw std::runtime_error("Usage: maze_convert [--text] <maze files or directories> <output file>");
+    }
+
+    options.output = options.inputs.back();
+    options.inputs.pop_back();
+
+    return options;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options       options = parse_options(argc, argv);
+        std::ofstream output(options.output, std::ios::binary);
+        std::size_t   count = 0;
+
+        if (not output) {
+            throw std::runtime_error("Could not create file " + options.output);
+        }
+
+        for (const auto& input : options.inputs) {
+            // Both formats are accepted as input, so records can be turned back into drawings
+            if (MazeRecordReader::is_binary(input)) {
+                MazeRecordReader reader(input);
+                convert<MazeRecord>(reader, output, options.text, count);
+            } else {
+                MazeReader reader(input);
+                convert<MazeText>(reader, output, options.text, count);
+            }
+        }
+
+        output.close();
+
+        if (not output) {
+            throw std::runtime_error("Could not write file " + options.output);
+        }
+
+        std::cerr << count << " mazes written to " << options.output << '\n';
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "maze_generator.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+/**
+ * @brief Names of the algorithms, in the order of the algorithms
+ */
+constexpr std::array<const char*, 5> algorithm_names = {"backtracker", "kruskal", "prim", "braided", "competition"};
+
+/**
+ * @brief Number of mazes generated before writing them, bounding the memory used by the largest mazes
+ */
+constexpr std::size_t batch_size = 1024;
+
+/**
+ * @brief Type to store the command line options
+ */
+struct Options {
+    std::string filename;
+    std::size_t count{1};
+    uint64_t    seed{};
+    std::size_t thread_count{};
+    bool        all_algorithms{true};
+    uint8_t     algorithm{};
+    uint8_t     min_width{16};
+    uint8_t     max_width{16};
+    uint8_t     height{16};
+};
+
+/**
+ * @brief Parses a maze dimension
+ *
+ * @param text The dimension
+ * @return The dimension, from 1 to 255
+ */
+uint8_t parse_dimension(const std::string& text) {
+    unsigned long value = std::stoul(text);
+
+    if (value < 1 or value > UINT8_MAX) {
+        throw std::runtime_error("Maze dimensions go from 1 to 255, found " + text);
+    }
+
+    return static_cast<uint8_t>(value);
+}
+
+/**
+ * @brief Generates a maze of the corpus
+ *
+ * @param options The command line options
+ * @param index The index of the maze in the corpus
+ * @return The drawing of the maze
+ */
+std::string generate(const Options& options, std::size_t index) {
+    uint64_t seed = MazeGenerator::derive_seed(options.seed, index);
+    uint8_t  width = options.min_width;
+    uint8_t  height = options.height;
+
+    // Square mazes of random sizes take their size from the seed, so it does not depend on the algorithm
+    if (options.max_width != options.min_width) {
+        uint64_t range = options.max_width - options.min_width + 1;
+        width = options.min_width + MazeGenerator::derive_seed(seed, 0) % range;
+        height = width;
+    }
+
+    std::size_t        algorithm = options.all_algorithms ? index % algorithm_names.size() : options.algorithm;
+    MazeGenerator      generator(seed);
+    std::ostringstream text;
+    generator.generate(static_cast<MazeAlgorithm>(algorithm), width, height).write_text(text);
+
+    return text.str();
+}
+
+/**
+ * @brief Parses the command line options
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The parsed options
+ */
+Options parse_options(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--algorithm" and i + 1 < argc) {
+            std::string name = argv[++i];
+            auto        found = std::find(algorithm_names.begin(), algorithm_names.end(), name);
+
+            options.all_algorithms = name == "all";
+
+            if (not options.all_algorithms and found == algorithm_names.end()) {
+                throw std::runtime_error(
+                    "Unknown algorithm " + name + ", expected backtracker, kruskal, prim, braided, competition or all"
+                );
+            }
+
+            options.algorithm = std::distance(algorithm_names.begin(), found);
+        } else if (argument == "--size" and i + 1 < argc) {
+            std::string size = argv[++i];
+            std::size_t separator = size.find_first_of("x-");
+
+            if (separator == std::string::npos) {
+                options.min_width = options.max_width = options.height = parse_dimension(size);
+            } else if (size[separator] == 'x') {
+                options.min_width = options.max_width = parse_dimension(size.substr(0, separator));
+                options.height = parse_dimension(size.substr(separator + 1));
+            } else {
+                options.min_width = parse_dimension(size.substr(0, separator));
+                options.max_width = parse_dimension(size.substr(separator + 1));
+
+                if (options.min_width > options.max_width) {
+                    throw std::runtime_error("Empty size range " + size);
+                }
+            }
+        } else if (argument == "--count" and i + 1 < argc) {
+            options.count = std::stoul(argv[++i]);
+        } else if (argument == "--seed" and i + 1 < argc) {
+            options.seed = std::stoull(argv[++i]);
+        } else if (argument == "--threads" and i + 1 < argc) {
+            options.thread_count = std::stoul(argv[++i]);
+        } else if (argument.starts_with("--") or not options.filename.empty()) {
+            throw std::runtime_error("Unknown option " + argument);
+        } else {
+            options.filename = argument;
+        }
+    }
+
+    if (options.filename.empty()) {
+        throw std::runtime_error(
+            "Usage: maze_generate [--algorithm backtracker|kruskal|prim|braided|competition|all] "
+            "[--size N|WxH|MIN-MAX] [--count N] [--seed N] [--threads N] <output file>"
+        );
+    }
+
+    return options;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options       options = parse_options(argc, argv);
+        std::ofstream output(options.filename);
+        auto          start = std::chrono::steady_clock::now();
+
+        if (not output) {
+            throw std::runtime_error("Could not create file " + options.filename);
+        }
+
+        ThreadPool               pool(options.thread_count);
+        std::vector<std::string> drawings(std::min(batch_size, options.count));
+
+        // Each maze has its own seed, so the corpus is the same whatever the number of threads
+        for (std::size_t first = 0; first < options.count; first += batch_size) {
+            std::size_t count = std::min(batch_size, options.count - first);
+
+            for (std::size_t i = 0; i < count; i++) {
+                pool.submit([&options, &drawing = drawings[i], index = first + i]() {
+                    drawing = generate(options, index);
+                });
+            }
+
+            pool.wait();
+
+            for (std::size_t i = 0; i < count; i++) {
+                // Drawings are separated by blank lines
+                output << (first + i > 0 ? "\n" : "") << drawings[i];
+            }
+        }
+
+        output.close();
+
+        if (not output) {
+            throw std::runtime_error("Could not write file " + options.filename);
+        }
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cerr << options.count << " mazes written to " << options.filename << " in " << std::fixed
+                  << std::setprecision(3) << elapsed << " s, " << pool.get_thread_count() << " threads\n";
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "micras.hpp"
+#include "renderer.hpp"
+#include "sensor_model.hpp"
+#include "trace.hpp"
+
+namespace {
+/**
+ * @brief Type to store the command line options
+ */
+struct Options {
+    std::string                filename;
+    std::optional<uint32_t>    run_id;
+    bool                       show{};
+    bool                       steps{};
+    std::optional<SensorModel> sensor_model;
+};
+
+/**
+ * @brief Type to store the state of a run being replayed
+ */
+struct Replay {
+    TraceRun                          run;
+    std::optional<Micras<0, 0>>       micras;
+    std::optional<RoutePlanner<0, 0>> route_planner;
+    uint32_t                          step_count{};
+    std::optional<uint32_t>           divergence;
+    std::chrono::nanoseconds          update_time{};
+    std::chrono::nanoseconds          step_time{};
+};
+
+/**
+ * @brief Returns a pose as text
+ *
+ * @param pose The pose
+ * @return The position and orientation of the pose
+ */
+std::string pose_text(const GridPose& pose) {
+    constexpr std::array<char, 4> sides = {'R', 'U', 'L', 'D'};
+    return "(" + std::to_string(pose.position.x) + ", " + std::to_string(pose.position.y) + ", " +
+           sides.at(pose.orientation) + ")";
+}
+
+/**
+ * @brief Returns the pose the robot reaches after a step, as recorded in the trace
+ *
+ * @param step The step record
+ * @return The pose after the step
+ */
+GridPose expected_pose(const TraceStep& step) {
+    GridPose pose = step.pose;
+    Side     direction = pose.position.direction(step.goal);
+
+    if ((step.flags & TraceStep::bumped) != 0) {
+        pose.position = step.goal;
+    } else if (direction == pose.orientation) {
+        pose.position = step.goal;
+    } else {
+        pose.orientation = direction;
+    }
+
+    return pose;
+}
+
+/**
+ * @brief Prints the outcome of a replayed run
+ *
+ * @param replay The replayed run
+ * @param options The command line options
+ */
+void finish_run(const Replay& replay, const Options& options) {
+    std::cout << "run " << replay.run.id << ": " << +replay.run.width << "x" << +replay.run.height << ", "
+              << replay.step_count << " steps, ";
+
+    if (replay.divergence) {
+        std::cout << "diverged at step " << *replay.divergence;
+    } else {
+        std::cout << "reproduced";
+    }
+
+    double count = std::max<double>(replay.step_count, 1);
+
+    // The trace only times the update of the known maze, while the replay times the whole step
+    std::cout << ", " << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double, std::micro>(replay.update_time).count() / count
+              << " us recorded update, " << std::chrono::duration<double, std::micro>(replay.step_time).count() / count
+              << " us replayed step\n";
+
+    if (options.show) {
+        Renderer<0, 0> renderer({replay.run.width, replay.run.height});
+        renderer.write(std::cout, replay.micras->get_known_maze(), replay.micras->get_pose());
+    }
+}
+
+/**
+ * @brief Replays a step against the known maze, checking that the robot takes the recorded decision
+ *
+ * @param replay The run being replayed
+ * @param step The step record
+ * @param options The command line options
+ */
+void replay_step(Replay& replay, const TraceStep& step, const Options& options) {
+    Micras<0, 0>& micras = *replay.micras;
+    uint32_t      index = replay.step_count++;
+
+    if (replay.divergence) {
+        return;
+    }
+
+    if (micras.get_pose() != step.pose) {
+        std::cout << "run " << replay.run.id << ": step " << index << ": recorded pose " << pose_text(step.pose)
+                  << ", replayed pose " << pose_text(micras.get_pose()) << '\n';
+        replay.divergence = index;
+        return;
+    }
+
+    // Hitting a wall is not a decision of the robot, so it is applied as recorded
+    if ((step.flags & TraceStep::bumped) != 0) {
+        micras.bump();
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        micras.step(step.information);
+        replay.step_time += std::chrono::steady_clock::now() - start;
+        replay.update_time += std::chrono::nanoseconds(step.update_time);
+    }
+
+    const KnownMaze<0, 0>& known_maze = micras.get_known_maze();
+    uint8_t flags = (known_maze.is_exploring() ? TraceStep::exploring : 0) |
+                    (known_maze.is_returning() ? TraceStep::returning : 0) | (step.flags & TraceStep::bumped);
+
+    if ((step.flags & TraceStep::bumped) == 0 and micras.get_straight_run() > 0) {
+        flags |= TraceStep::driven_through;
+    }
+
+    if (options.steps) {
+        std::cout << "run " << replay.run.id << ": step " << index << ": " << pose_text(step.pose) << " -> "
+                  << pose_text(micras.get_pose()) << (known_maze.is_exploring() ? " exploring" : "")
+                  << (known_maze.is_returning() ? " returning" : "") << '\n';
+    }
+
+    if (micras.get_pose() != expected_pose(step) or flags != step.flags) {
+        std::cout << "run " << replay.run.id << ": step " << index << ": recorded " << pose_text(expected_pose(step))
+                  << " flags " << +step.flags << ", replayed " << pose_text(micras.get_pose()) << " flags " << +flags
+                  << '\n';
+        replay.divergence = index;
+    }
+}
+
+/**
+ * @brief Parses the command line options
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The parsed options
+ */
+Options parse_options(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--run" and i + 1 < argc) {
+            options.run_id = std::stoul(argv[++i]);
+        } else if (argument == "--show") {
+            options.show = true;
+        } else if (argument == "--steps") {
+            options.steps = true;
+        } else if (argument == "--noise" and i + 1 < argc) {
+            options.sensor_model = SensorModel::parse(argv[++i]);
+        } else if (argument.starts_with("--") or not options.filename.empty()) {
+            throw std::runtime_error("Unknown option " + argument);
+        } else {
+            options.filename = argument;
+        }
+    }
+
+    if (options.filename.empty()) {
+        throw std::runtime_error(
+            "Usage: maze_replay [--run ID] [--show] [--steps] [--noise FP,FN[,RANGE]] <trace file>"
+        );
+    }
+
+    return options;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t run_count = 0;
+    std::size_t diverged_count = 0;
+
+    try {
+        Options               options = parse_options(argc, argv);
+        TraceReader           reader(options.filename);
+        TraceRecord           record{};
+        std::optional<Replay> replay;
+
+        // Steps of the runs filtered out by their identification are skipped along with their run record
+        bool skipping = false;
+
+        auto finish = [&]() {
+            if (replay) {
+                finish_run(*replay, options);
+                run_count++;
+                diverged_count += replay->divergence ? 1 : 0;
+                replay.reset();
+            }
+        };
+
+        while (reader.next(record)) {
+            if (record.run.type == TraceRecordType::RUN) {
+                finish();
+                skipping = options.run_id and *options.run_id != record.run.id;
+
+                if (skipping) {
+                    continue;
+                }
+
+                if (record.run.start.position.x >= record.run.width or
+                    record.run.start.position.y >= record.run.height or record.run.strategy > FRONTIER) {
+                    throw std::runtime_error(
+                        options.filename + ": byte " + std::to_string(reader.get_offset() - sizeof(TraceRecord)) +
+                        ": invalid run record"
+                    );
+                }
+
+                replay.emplace();
+                replay->run = record.run;
+                replay->micras.emplace(record.run.start, GridSize<0, 0>{record.run.width, record.run.height});
+                replay->micras->set_exploration_strategy(static_cast<ExplorationStrategy>(record.run.strategy));
+
+                if ((record.run.flags & TraceRun::route_planner) != 0) {
+                    replay->route_planner.emplace(MotionProfile{}, GridSize<0, 0>{record.run.width, record.run.height});
+                    replay->micras->set_route_planner(&*replay->route_planner);
+                }
+
+                replay->micras->set_goal(record.run.goal_position, record.run.goal_width, record.run.goal_height);
+
+                // The noise itself is not recorded, only the readings it produced, but the robot weighs them with it
+                if ((record.run.flags & TraceRun::noisy_sensors) != 0 and not options.sensor_model) {
+                    throw std::runtime_error(
+                        options.filename + ": run " + std::to_string(record.run.id) +
+                        " used noisy sensors, give the same --noise as the recorded run"
+                    );
+                }
+
+                replay->micras->set_sensor_model(options.sensor_model.value_or(SensorModel{}));
+                continue;
+            }
+
+            if (skipping) {
+                continue;
+            }
+
+            if (not replay) {
+                throw std::runtime_error(
+                    options.filename + ": byte " + std::to_string(reader.get_offset() - sizeof(TraceRecord)) +
+                    ": step record before any run record"
+                );
+            }
+
+            replay_step(*replay, record.step, options);
+        }
+
+        finish();
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    std::cerr << run_count << " runs replayed, " << diverged_count << " diverged\n";
+
+    return diverged_count == 0 ? 0 : 2;
+}
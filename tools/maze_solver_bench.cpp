@@ -0,0 +1,642 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <unistd.h>
+
+#include "costmap.hpp"
+#include "hierarchical_planner.hpp"
+#include "known_maze.hpp"
+#include "large_maze.hpp"
+#include "maze.hpp"
+#include "maze_generator.hpp"
+#include "maze_reader.hpp"
+#include "maze_snapshot.hpp"
+#include "micras.hpp"
+#include "profiler.hpp"
+#include "simulation.hpp"
+#include "wall_map.hpp"
+
+namespace {
+/**
+ * @brief Type to store the command line options
+ */
+struct Options {
+    std::string format{"table"};
+    std::string filter;
+    double      min_time{0.1};
+    uint32_t    repetitions{5};
+};
+
+/**
+ * @brief Type to store the measurements of a benchmark
+ */
+struct BenchmarkResult {
+    std::string name;
+    uint64_t    iterations{};
+    uint64_t    items{};
+    double      real_time{};
+    double      cpu_time{};
+    double      min_time{};
+    double      deviation{};
+};
+
+/**
+ * @brief Possible layouts of the generated mazes
+ */
+enum MazeKind : uint8_t {
+    EMPTY = 0,
+    SPIRAL,
+    CHECKERBOARD,
+    COMPETITION
+};
+
+/**
+ * @brief Names of the maze layouts, in the order of the layouts
+ */
+constexpr std::array<const char*, 4> maze_kind_names = {"empty", "spiral", "checkerboard", "competition"};
+
+/**
+ * @brief Keeps the compiler from optimizing away a value computed by a benchmark
+ *
+ * @param value The value to be kept
+ */
+template <typename T>
+void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");  // NOLINT(hicpp-no-assembler)
+}
+
+/**
+ * @brief Returns the CPU time used by the calling thread
+ *
+ * @return The CPU time in seconds
+ */
+double thread_cpu_time() {
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief Class for running the benchmarks and writing their results
+ */
+class BenchmarkSuite {
+public:
+    /**
+     * @brief Construct a new BenchmarkSuite object
+     *
+     * @param options The command line options
+     */
+    explicit BenchmarkSuite(const Options& options) : options(options) { }
+
+    /**
+     * @brief Runs a benchmark, unless it is filtered out
+     *
+     * @details The iteration count is grown until a repetition lasts the minimum time, then the repetitions are
+     *          measured with that count and the median is kept.
+     *
+     * @param name The name of the benchmark
+     * @param body The code to be measured, returning the number of items it processed
+     */
+    template <typename Body>
+    void run(const std::string& name, Body body) {
+        if (name.find(this->options.filter) == std::string::npos) {
+            return;
+        }
+
+        BenchmarkResult result{name};
+        uint64_t        iterations = 1;
+
+        while (true) {
+            auto start = std::chrono::steady_clock::now();
+
+            for (uint64_t i = 0; i < iterations; i++) {
+                result.items = body();
+            }
+
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (elapsed >= this->options.min_time) {
+                break;
+            }
+
+            // Overshooting the estimate a little avoids another round close to the minimum time
+            double scale = elapsed > 0 ? 1.4 * this->options.min_time / elapsed : 10.0;
+            iterations = static_cast<uint64_t>(std::ceil(iterations * std::clamp(scale, 1.5, 10.0)));
+        }
+
+        std::vector<double> real_times;
+        std::vector<double> cpu_times;
+
+        for (uint32_t repetition = 0; repetition < this->options.repetitions; repetition++) {
+            auto   start = std::chrono::steady_clock::now();
+            double cpu_start = thread_cpu_time();
+
+            for (uint64_t i = 0; i < iterations; i++) {
+                keep(body());
+            }
+
+            double cpu_elapsed = thread_cpu_time() - cpu_start;
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            real_times.push_back(elapsed * 1e9 / static_cast<double>(iterations));
+            cpu_times.push_back(cpu_elapsed * 1e9 / static_cast<double>(iterations));
+        }
+
+        double mean = 0;
+
+        for (double time : real_times) {
+            mean += time / static_cast<double>(real_times.size());
+        }
+
+        for (double time : real_times) {
+            result.deviation += (time - mean) * (time - mean) / static_cast<double>(real_times.size());
+        }
+
+        std::sort(real_times.begin(), real_times.end());
+        std::sort(cpu_times.begin(), cpu_times.end());
+
+        result.iterations = iterations;
+        result.real_time = real_times[real_times.size() / 2];
+        result.cpu_time = cpu_times[cpu_times.size() / 2];
+        result.min_time = real_times.front();
+        result.deviation = std::sqrt(result.deviation);
+
+        if (this->options.format == "table") {
+            write_row(std::cout, result);
+        }
+
+        this->results.push_back(result);
+    }
+
+    /**
+     * @brief Writes the results in the chosen format, the table rows being written as the benchmarks run
+     */
+    void finish() const {
+        if (this->options.format == "json") {
+            this->write_json(std::cout);
+        } else if (this->options.format == "csv") {
+            this->write_csv(std::cout);
+        }
+    }
+
+    /**
+     * @brief Writes the header of the table
+     *
+     * @param os The output stream
+     */
+    static void write_table_header(std::ostream& os) {
+        os << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "time [ns]" << std::setw(12)
+           << "cpu [ns]" << std::setw(12) << "min [ns]" << std::setw(9) << "dev %" << std::setw(12) << "iterations"
+           << std::setw(10) << "items" << std::setw(12) << "ns/item" << '\n';
+    }
+
+private:
+    /**
+     * @brief Writes a result as a row of the table
+     *
+     * @param os The output stream
+     * @param result The result
+     */
+    static void write_row(std::ostream& os, const BenchmarkResult& result) {
+        os << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(1)
+           << std::setw(12) << result.real_time << std::setw(12) << result.cpu_time << std::setw(12)
+           << result.min_time << std::setw(9) << 100.0 * result.deviation / result.real_time << std::setw(12)
+           << result.iterations << std::setw(10) << result.items << std::setprecision(2) << std::setw(12)
+           << result.real_time / static_cast<double>(std::max<uint64_t>(result.items, 1)) << '\n';
+    }
+
+    /**
+     * @brief Writes the results as a JSON object, laid out like the output of Google Benchmark
+     *
+     * @param os The output stream
+     */
+    void write_json(std::ostream& os) const {
+        std::time_t now = std::time(nullptr);
+        std::string date(32, '\0');
+        date.resize(std::strftime(date.data(), date.size(), "%Y-%m-%dT%H:%M:%S", std::localtime(&now)));
+
+        os << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n    \"num_cpus\": "
+           << std::thread::hardware_concurrency() << ",\n    \"costmap_kernel\": \""
+#ifdef COSTMAP_KERNEL_WAVEFRONT
+           << "wavefront"
+#else
+           << "scalar"
+#endif
+           << "\",\n    \"profiling\": " << (Profiler::enabled ? "true" : "false") << ",\n    \"repetitions\": "
+           << this->options.repetitions << "\n  },\n  \"benchmarks\": [";
+
+        for (std::size_t i = 0; i < this->results.size(); i++) {
+            const BenchmarkResult& result = this->results[i];
+
+            os << (i > 0 ? "," : "") << "\n    {\"name\": \"" << result.name << "\", \"iterations\": "
+               << result.iterations << ", \"items_per_iteration\": " << result.items << std::fixed
+               << std::setprecision(3) << ", \"real_time\": " << result.real_time << ", \"cpu_time\": "
+               << result.cpu_time << ", \"min_time\": " << result.min_time << ", \"stddev\": " << result.deviation
+               << ", \"time_unit\": \"ns\"}";
+        }
+
+        os << "\n  ]\n}\n";
+    }
+
+    /**
+     * @brief Writes the results as comma separated values
+     *
+     * @param os The output stream
+     */
+    void write_csv(std::ostream& os) const {
+        os << "name,iterations,items_per_iteration,real_time_ns,cpu_time_ns,min_time_ns,stddev_ns\n";
+
+        for (const auto& result : this->results) {
+            os << result.name << ',' << result.iterations << ',' << result.items << ',' << std::fixed
+               << std::setprecision(3) << result.real_time << ',' << result.cpu_time << ',' << result.min_time << ','
+               << result.deviation << '\n';
+        }
+    }
+
+    /**
+     * @brief Command line options
+     */
+    Options options;
+
+    /**
+     * @brief Results of the benchmarks already run
+     */
+    std::vector<BenchmarkResult> results;
+};
+
+/**
+ * @brief Generates the walls of a maze
+ *
+ * @param kind The layout of the maze
+ * @param width The width of the maze
+ * @param height The height of the maze
+ * @return The walls of the maze
+ */
+MazeLayout generate_layout(MazeKind kind, uint8_t width, uint8_t height) {
+    if (kind == MazeKind::COMPETITION) {
+        return MazeGenerator(width * 256 + height).generate(MazeAlgorithm::COMPETITION, width, height);
+    }
+
+    MazeLayout layout(width, height, kind == MazeKind::SPIRAL);
+
+    if (kind == MazeKind::CHECKERBOARD) {
+        // Alternating walls leave only staircase corridors, so most cells cannot reach the goal
+        for (uint8_t y = 0; y < height; y++) {
+            for (uint8_t x = 0; x < width; x++) {
+                layout.set_wall({{x, y}, Side::RIGHT}, (x + y) % 2 == 0);
+                layout.set_wall({{x, y}, Side::UP}, (x + y) % 2 == 1);
+            }
+        }
+    } else if (kind == MazeKind::SPIRAL) {
+        // A single corridor winding inwards from the start, so the robot has to go through every cell
+        std::vector<bool> visited(width * height);
+        GridPose          pose{{0, 0}, Side::UP};
+        visited[0] = true;
+
+        for (uint32_t count = 1; count < static_cast<uint32_t>(width * height); count++) {
+            GridPoint next = pose.front().position;
+
+            if (not layout.is_inside(next) or visited[next.y * width + next.x]) {
+                pose = pose.turned_right();
+                next = pose.front().position;
+            }
+
+            layout.set_wall(pose, false);
+            visited[next.y * width + next.x] = true;
+            pose.position = next;
+        }
+    }
+
+    return layout;
+}
+
+/**
+ * @brief Runs the benchmarks of a maze
+ *
+ * @param suite The benchmark suite
+ * @param text The drawing of the maze
+ * @param layout The walls of the maze
+ * @param suffix The layout and size of the maze, appended to the benchmark names
+ */
+template <uint8_t width, uint8_t height>
+void run_maze(BenchmarkSuite& suite, const MazeText& text, const MazeLayout& layout, const std::string& suffix) {
+    constexpr GridPose start{{0, 0}, Side::UP};
+
+    Maze<width, height>    maze(text);
+    WallMap<width, height> walls;
+
+    for (uint8_t y = 0; y < height; y++) {
+        for (uint8_t x = 0; x < width; x++) {
+            walls.set_wall({{x, y}, Side::RIGHT}, layout.has_wall({{x, y}, Side::RIGHT}));
+            walls.set_wall({{x, y}, Side::UP}, layout.has_wall({{x, y}, Side::UP}));
+        }
+    }
+
+    // Robots stuck in the mazes without a route to the goal are stopped after a few passes over every cell
+    uint32_t max_steps = 20 * width * height;
+
+    suite.run("maze_parse/" + suffix, [&]() {
+        Maze<width, height> parsed(text);
+        keep(parsed);
+        return 1;
+    });
+
+    suite.run("get_information/" + suffix, [&]() {
+        for (uint8_t y = 0; y < height; y++) {
+            for (uint8_t x = 0; x < width; x++) {
+                for (uint8_t side = Side::RIGHT; side <= Side::DOWN; side++) {
+                    keep(maze.get_information({{x, y}, static_cast<Side>(side)}));
+                }
+            }
+        }
+
+        return 4 * width * height;
+    });
+
+    // The updates are replayed from a run of the robot, so the walls are found in the order of a real exploration
+    std::vector<std::pair<GridPose, Information>> readings;
+    Micras<width, height>                         micras(start);
+
+    for (uint32_t step = 0; step < max_steps and micras.get_known_maze().is_exploring(); step++) {
+        readings.emplace_back(micras.get_pose(), maze.get_information(micras.get_pose()));
+        micras.step(readings.back().second);
+    }
+
+    // The fast run and snapshot benchmarks need the map of the whole exploration, even with the update one filtered out
+    KnownMaze<width, height> explored_maze(start);
+
+    for (const auto& [pose, information] : readings) {
+        explored_maze.update(pose, information);
+    }
+
+    KnownMaze<width, height> known_maze(start);
+
+    suite.run("known_maze_update/" + suffix, [&]() {
+        known_maze.reset(start);
+
+        for (const auto& [pose, information] : readings) {
+            known_maze.update(pose, information);
+        }
+
+        return readings.size();
+    });
+
+    Costmap<width, height> costmap;
+
+    suite.run("costmap/" + suffix, [&]() {
+        costmap.reset(walls, known_maze.get_goal());
+        keep(costmap.get_cost(start.position));
+        return width * height;
+    });
+
+    // The fast run follows the best route, compared with the goal set and the route keyed by cost used before
+    std::vector<GridPoint> route{start.position};
+
+    while (route.size() < width * height and not explored_maze.get_goal().contains(route.back())) {
+        route.push_back(explored_maze.get_current_goal(route.back()));
+    }
+
+    std::map<uint16_t, GridPoint, std::greater<>> cost_route;
+    std::unordered_set<GridPoint>                 goal_cells;
+
+    for (const GridPoint& position : route) {
+        cost_route.try_emplace(explored_maze.get_cost(position), position);
+    }
+
+    explored_maze.get_goal().for_each([&goal_cells](const GridPoint& position) { goal_cells.insert(position); });
+
+    if (explored_maze.get_goal().contains(route.back())) {
+        suite.run("get_current_goal/" + suffix, [&]() {
+            GridPoint position = start.position;
+
+            while (not explored_maze.get_goal().contains(position)) {
+                position = explored_maze.get_current_goal(position);
+            }
+
+            keep(position);
+            return route.size() - 1;
+        });
+
+        suite.run("get_current_goal_cost_map/" + suffix, [&]() {
+            GridPoint position = start.position;
+
+            while (not goal_cells.contains(position)) {
+                auto entry = cost_route.find(explored_maze.get_cost(position));
+
+                if (entry != cost_route.end() and entry->second == position) {
+                    position = std::next(entry)->second;
+                }
+            }
+
+            keep(position);
+            return route.size() - 1;
+        });
+    }
+
+    // Each hypothesis opens the wall on the right of a different cell and measures the route it would give
+    MazeSnapshot<width, height> snapshot(explored_maze);
+    WallMap<width, height>      what_if_walls;
+
+    suite.run("known_maze_fork/" + suffix, [&]() {
+        for (uint8_t x = 0; x < width; x++) {
+            KnownMaze<width, height> copy = explored_maze;
+            keep(copy);
+        }
+
+        return width;
+    });
+
+    suite.run("snapshot_fork/" + suffix, [&]() {
+        for (uint8_t x = 0; x < width; x++) {
+            MazeSnapshot<width, height> fork = snapshot;
+            fork.assume_wall({{x, height / 2}, Side::RIGHT}, false);
+            keep(fork.get_chunk_count());
+        }
+
+        return width;
+    });
+
+    suite.run("known_maze_what_if/" + suffix, [&]() {
+        for (uint8_t x = 0; x < width; x++) {
+            KnownMaze<width, height> copy = explored_maze;
+            what_if_walls = copy.get_walls();
+            what_if_walls.set_wall({{x, height / 2}, Side::RIGHT}, false);
+            costmap.reset(what_if_walls, copy.get_goal());
+            keep(costmap.get_cost(start.position));
+        }
+
+        return width;
+    });
+
+    suite.run("snapshot_what_if/" + suffix, [&]() {
+        for (uint8_t x = 0; x < width; x++) {
+            MazeSnapshot<width, height> fork = snapshot;
+            fork.assume_wall({{x, height / 2}, Side::RIGHT}, false);
+            keep(fork.get_route_distance(what_if_walls, costmap));
+        }
+
+        return width;
+    });
+
+    Simulation<width, height> simulation(start);
+
+    suite.run("micras_run/" + suffix, [&]() { return simulation.run(maze, max_steps).steps; });
+}
+
+/**
+ * @brief Runs the benchmarks of a maze too large for the grid classes
+ *
+ * @param suite The benchmark suite
+ * @param size The width and height of the maze
+ */
+void run_large_maze(BenchmarkSuite& suite, uint16_t size) {
+    std::string           suffix = "large/" + std::to_string(size);
+    LargeMaze             maze = MazeGenerator(size).generate_large(size, size);
+    LargePoint            start{0, 0};
+    LargePoint            goal{static_cast<uint16_t>(size - 1), static_cast<uint16_t>(size - 1)};
+    std::vector<uint32_t> distances(maze.get_cell_count());
+    std::vector<uint32_t> queue(maze.get_cell_count());
+
+    // A plain flood fill from the start is the baseline of the hierarchical queries
+    suite.run("large_flood_fill/" + suffix, [&]() {
+        std::fill(distances.begin(), distances.end(), HierarchicalPlanner::unreachable);
+        distances[maze.index(start)] = 0;
+        queue[0] = maze.index(start);
+
+        for (uint32_t head = 0, tail = 1; head < tail; head++) {
+            LargePoint position{
+                static_cast<uint16_t>(queue[head] % maze.get_width()),
+                static_cast<uint16_t>(queue[head] / maze.get_width())
+            };
+
+            for (uint8_t side = Side::RIGHT; side <= Side::DOWN; side++) {
+                uint32_t front = maze.index(position + static_cast<Side>(side));
+
+                if (not maze.has_wall(position, static_cast<Side>(side)) and
+                    distances[front] == HierarchicalPlanner::unreachable) {
+                    distances[front] = distances[queue[head]] + 1;
+                    queue[tail++] = front;
+                }
+            }
+        }
+
+        keep(distances[maze.index(goal)]);
+        return maze.get_cell_count();
+    });
+
+    HierarchicalPlanner planner;
+
+    suite.run("hierarchical_build/" + suffix, [&]() {
+        planner.build(maze);
+        return planner.get_portal_count();
+    });
+
+    suite.run("hierarchical_plan/" + suffix, [&]() {
+        keep(planner.plan(maze, start, goal));
+        return planner.get_route().size();
+    });
+}
+
+/**
+ * @brief Parses the command line options
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The parsed options
+ */
+Options parse_options(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--format" and i + 1 < argc) {
+            options.format = argv[++i];
+
+            if (options.format != "table" and options.format != "json" and options.format != "csv") {
+                throw std::runtime_error("Unknown format " + options.format + ", expected table, json or csv");
+            }
+        } else if (argument == "--filter" and i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (argument == "--min-time" and i + 1 < argc) {
+            options.min_time = std::stod(argv[++i]);
+        } else if (argument == "--repetitions" and i + 1 < argc) {
+            options.repetitions = std::max(1UL, std::stoul(argv[++i]));
+        } else {
+            throw std::runtime_error(
+                "Usage: maze_solver_bench [--format table|json|csv] [--filter TEXT] [--min-time SECONDS] "
+                "[--repetitions N]"
+            );
+        }
+    }
+
+    return options;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options        options = parse_options(argc, argv);
+        BenchmarkSuite suite(options);
+
+        // The mazes are written to files, so that parsing reads them the same way as the mazes of a corpus
+        std::filesystem::path directory =
+            std::filesystem::temp_directory_path() / ("maze_solver_bench_" + std::to_string(getpid()));
+        std::filesystem::create_directories(directory);
+
+        std::deque<MazeReader> readers;
+
+        for (uint8_t kind = MazeKind::EMPTY; kind <= MazeKind::COMPETITION; kind++) {
+            for (uint8_t size : {5, 16, 32}) {
+                MazeLayout  layout = generate_layout(static_cast<MazeKind>(kind), size, size);
+                std::string name = std::string(maze_kind_names[kind]) + "/" + std::to_string(size);
+                std::string filename = directory / (std::string(maze_kind_names[kind]) + std::to_string(size));
+
+                std::ofstream file(filename);
+                layout.write_text(file);
+                file.close();
+
+                MazeText text{};
+                readers.emplace_back(filename).next(text);
+
+                if (kind == MazeKind::EMPTY and size == 5 and options.format == "table") {
+                    BenchmarkSuite::write_table_header(std::cout);
+                }
+
+                if (size == 5) {
+                    run_maze<5, 5>(suite, text, layout, name);
+                } else if (size == 16) {
+                    run_maze<16, 16>(suite, text, layout, name);
+                } else {
+                    run_maze<32, 32>(suite, text, layout, name);
+                }
+            }
+        }
+
+        for (uint16_t size : {256, 1024}) {
+            run_large_maze(suite, size);
+        }
+
+        std::filesystem::remove_all(directory);
+        suite.finish();
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}